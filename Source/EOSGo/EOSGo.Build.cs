@@ -25,6 +25,7 @@ public class EOSGo : ModuleRules
 			new string[]
 			{
 				"Core",
+				"NetCore",
 				"OnlineSubsystem", 
 				"OnlineSubsystemUtils", 
 				"OnlineSubsystemEOS",
@@ -40,8 +41,10 @@ public class EOSGo : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"EngineSettings",
 				"Slate",
 				"SlateCore",
+				"TraceLog",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
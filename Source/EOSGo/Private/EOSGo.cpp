@@ -1,18 +1,73 @@
 // Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
 
 #include "EOSGo.h"
+#include "Subsystem/GoOperationMetrics.h"
+#include "Subsystem/GoMockOnlineBackend.h"
+#include "Subsystem/GoOnlineTrace.h"
+#include "Subsystem/GoLoadHarness.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
 
 #define LOCTEXT_NAMESPACE "FEOSGoModule"
 
+DEFINE_LOG_CATEGORY(LogEOSGo);
+DEFINE_LOG_CATEGORY(LogEOSGoAuth);
+DEFINE_LOG_CATEGORY(LogEOSGoSession);
+DEFINE_LOG_CATEGORY(LogEOSGoSearch);
+DEFINE_LOG_CATEGORY(LogEOSGoRegistration);
+
+FString EOSGo::RedactCredential(const FString& Credential)
+{
+	if (Credential.IsEmpty()) return TEXT("<empty>");
+	return FString::Printf(TEXT("<redacted %d chars>"), Credential.Len());
+}
+IOnlineSessionPtr EOSGo::GetSessionInterface()
+{
+#if !UE_BUILD_SHIPPING
+	if (FGoMockOnlineBackend::IsEnabled()) return FGoMockOnlineBackend::Get().GetSessionInterface();
+#endif
+
+	const IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get();
+	return Subsystem ? Subsystem->GetSessionInterface() : nullptr;
+}
+IOnlineIdentityPtr EOSGo::GetIdentityInterface()
+{
+#if !UE_BUILD_SHIPPING
+	if (FGoMockOnlineBackend::IsEnabled()) return FGoMockOnlineBackend::Get().GetIdentityInterface();
+#endif
+
+	const IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get();
+	return Subsystem ? Subsystem->GetIdentityInterface() : nullptr;
+}
+
 void FEOSGoModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if !UE_BUILD_SHIPPING
+	//~ Load clients are launched by the harness, which Shipping builds don't have.
+	FWorldDelegates::OnStartGameInstance.AddStatic(&UGoLoadClient::OnStartGameInstance);
+
+	//~ -EOSGoRecord[=File] traces every operation from startup, login included.
+	FString TraceFilename;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-EOSGoRecord="), TraceFilename) || FParse::Param(FCommandLine::Get(), TEXT("EOSGoRecord")))
+	{
+		FGoOnlineTraceRecorder::Get().Start(TraceFilename);
+	}
+#endif
 }
 
 void FEOSGoModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	//~ Leave the session's latency percentiles in the log.
+	if (GLog) FGoOperationMetrics::Get().Dump(*GLog);
+	FGoOnlineTraceRecorder::Get().Stop();
+#if !UE_BUILD_SHIPPING
+	//~ Mock completions must not outlive the objects they call back into.
+	if (FGoMockOnlineBackend::IsEnabled()) FGoMockOnlineBackend::Get().Reset();
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -12,6 +12,7 @@
 AGoGameStateBase::AGoGameStateBase()
 {
 	SetReplicates(true);
+	PlayerRoster.Owner = this;
 
 	if (AGameModeBase* GameModeBase = UGameplayStatics::GetGameMode(GetWorld()))
 	{
@@ -20,8 +21,8 @@ AGoGameStateBase::AGoGameStateBase()
 	if (GoGameModeBase)
 	{
 		//~ Bind callbacks.
-		GoGameModeBase->GoOnRegisterPlayerComplete.AddDynamic(this, &AGoGameStateBase::OnRegisteredPlayer);
-		GoGameModeBase->GoOnUnregisterPlayerComplete.AddDynamic(this, &AGoGameStateBase::OnUnregisteredPlayer);
+		GoGameModeBase->GoOnRegisterPlayerResult.AddUObject(this, &AGoGameStateBase::OnRegisteredPlayerResult);
+		GoGameModeBase->GoOnUnregisterPlayerResult.AddUObject(this, &AGoGameStateBase::OnUnregisteredPlayerResult);
 	}
 }
 
@@ -38,6 +39,7 @@ void AGoGameStateBase::BeginPlay()
 	{
 		//~ Bind session callbacks.
 		GoSubsystem->GoOnStartSessionComplete.AddDynamic(this, &AGoGameStateBase::OnStartedSession);
+		GoSubsystem->GoOnSessionOperationComplete.AddUObject(this, &AGoGameStateBase::OnSessionOperationComplete);
 	}
 }
 
@@ -45,97 +47,181 @@ void AGoGameStateBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	// Add the PlayerList to the list of replicated properties.
-	DOREPLIFETIME(AGoGameStateBase, PlayerList);
+	// Add the PlayerRoster to the list of replicated properties.
+	DOREPLIFETIME(AGoGameStateBase, PlayerRoster);
 	DOREPLIFETIME(AGoGameStateBase, MatchStartedText);
 }
 
-void AGoGameStateBase::OnRegisteredPlayer(bool bWasSuccessful)
-{
-	if (!bWasSuccessful) return;
-	if (!HasAuthority()) return;
-	CheckSessionToAdvertise(true);
-	PlayerListChanged();
-}
-void AGoGameStateBase::OnUnregisteredPlayer(bool bWasSuccessful)
-{
-	if (!bWasSuccessful) return;
-	if (!HasAuthority()) return;
-	CheckSessionToAdvertise(false);
-	PlayerListChanged();
-}
 void AGoGameStateBase::OnStartedSession(bool bWasSuccessful) 
 {
 	if (bWasSuccessful) MatchStartedText = FName("SESSION HAS STARTED!");
 	OnSessionStarted.Broadcast(bWasSuccessful);
 }
-
-void AGoGameStateBase::CheckSessionToAdvertise(bool bIsRegisteringPlayer)
+void AGoGameStateBase::OnSessionOperationComplete(FName SessionName, EGoSessionOperationType Type, bool bWasSuccessful)
 {
-	if (IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get())
+	if (Type != EGoSessionOperationType::Start || !bWasSuccessful || !HasAuthority()) return;
+
+	//~ Only the players of the started session move to the match.
+	for (const FGoPlayerRosterEntry* Entry : PlayerRoster.SetSessionStates(SessionName, EGoPlayerRosterState::InMatch))
 	{
-		SessionInterface = Subsystem->GetSessionInterface();
+		HandleRosterEntryChanged(*Entry);
 	}
-	
-	if (!SessionInterface.IsValid()) return;
+	RefreshSessionAdvertising(SessionName);
+}
+void AGoGameStateBase::OnRegisteredPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccessful)
+{
+	if (!bWasSuccessful) return;
+	if (!HasAuthority()) return;
 
-	FOnlineSession* GoSession = SessionInterface->GetNamedSession(NAME_GameSession);
-	FString Value;
-	GoSession->SessionSettings.Get(FName("MATCH_TYPE"), Value);
+	//~ UPDATE PLAYER ROSTER - add or refresh only the registered player.
+	const FUniqueNetIdRepl RosterId(PlayerId);
+	for (const TObjectPtr<APlayerState>& PlayerState : PlayerArray)
+	{
+		if (!PlayerState || PlayerState->GetUniqueId() != RosterId) continue;
 
-	if (Value.IsEmpty()) LogMessage("Retrieved MatchType variable via online service is empty");
-	FName Type = FName(Value);
+		AddToRoster(PlayerState);
+		return;
+	}
+}
+void AGoGameStateBase::AddToRoster(const APlayerState* PlayerState)
+{
+	if (!HasAuthority() || !PlayerState || !PlayerState->GetUniqueId().IsValid()) return;
 
-	if (bIsRegisteringPlayer)
+	const FUniqueNetIdRepl& RosterId = PlayerState->GetUniqueId();
+	const FName SessionName = GoGameModeBase ? GoGameModeBase->GetPlayerSessionName(RosterId) : NAME_GameSession;
+	const bool bIsNewEntry = !PlayerRoster.Entries.ContainsByPredicate([&RosterId](const FGoPlayerRosterEntry& It) { return It.PlayerId == RosterId; });
+	if (const FGoPlayerRosterEntry* Entry = PlayerRoster.AddOrUpdate(RosterId, PlayerState->GetPlayerName(), SessionName, EGoPlayerRosterState::InLobby))
 	{
-		if (Type == "DUO")
+		if (bIsNewEntry)
 		{
-			LogMessage("Updating DUO session");
-			if (PlayerArray.Num() == 2) UpdateSessionAdvertising(false);
+			HandleRosterEntryAdded(*Entry);
+			RefreshSessionAdvertising(SessionName);
 		}
-		else if (Type == "TRIO")
+		else
 		{
-			LogMessage("Updating TRIO session");
-			if (PlayerArray.Num() == 3) UpdateSessionAdvertising(false);
-		}
-		else if (Type == "SQUAD")
-		{
-			LogMessage("Updating SQUAD session");
-			if (PlayerArray.Num() == 4) UpdateSessionAdvertising(false);
+			HandleRosterEntryChanged(*Entry);
 		}
+		BroadcastPlayerListChanged();
 	}
 }
-void AGoGameStateBase::UpdateSessionAdvertising(bool InShouldAdvertise)
+void AGoGameStateBase::OnUnregisteredPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccessful)
 {
-	if (const UGameInstance* GameInstance = GetGameInstance())
+	if (!HasAuthority()) return;
+	RemoveFromRoster(FUniqueNetIdRepl(PlayerId));
+}
+void AGoGameStateBase::RemovePlayerState(APlayerState* PlayerState)
+{
+	//~ Drop the leaving player right away instead of waiting for the unregistration round trip.
+	//~ Player states torn down by a seamless travel stay on the roster; the new game state takes them back on arrival.
+	const UWorld* World = GetWorld();
+	if (PlayerState && HasAuthority() && !(World && World->IsInSeamlessTravel())) RemoveFromRoster(PlayerState->GetUniqueId());
+	Super::RemovePlayerState(PlayerState);
+}
+
+TArray<FGoPlayerRosterEntry> AGoGameStateBase::GetSessionPlayerRoster(FName SessionName) const
+{
+	return PlayerRoster.Entries.FilterByPredicate([SessionName](const FGoPlayerRosterEntry& Entry) { return Entry.SessionName == SessionName; });
+}
+
+bool AGoGameStateBase::ShouldAdvertiseSession(FName SessionName) const
+{
+	if (!SessionInterface.IsValid()) return false;
+
+	const FOnlineSessionSettings* LiveSettings = SessionInterface->GetSessionSettings(SessionName);
+	if (!LiveSettings) return false;
+
+	//~ Capacity comes from the match type registry; sessions of unregistered types use their own settings.
+	int32 MaxPlayers = LiveSettings->NumPublicConnections;
+	if (const FGoMatchType* MatchType = GoSubsystem ? GoSubsystem->GetCurrentMatchType(SessionName) : nullptr)
 	{
-		GoSubsystem = GameInstance->GetSubsystem<UGoSubsystem>();
+		MaxPlayers = MatchType->Definition.MaxPlayers;
 	}
 
-	//~ Set new session settings.
-	TSharedPtr<FOnlineSessionSettings> NewSessionSettings = MakeShared<FOnlineSessionSettings>();
-	NewSessionSettings->bShouldAdvertise = InShouldAdvertise;
+	//~ A started session only takes players if it allows joining in progress.
+	const bool bIsJoinable = LiveSettings->bAllowJoinInProgress || !GoSubsystem || GoSubsystem->GetNamedSessionState(SessionName) != EGoSessionState::InProgress;
+	const int32 NumReserved = GoGameModeBase ? GoGameModeBase->GetNumReservedSlots(SessionName) : 0;
+	return bIsJoinable && PlayerRoster.NumSessionEntries(SessionName) + NumReserved < MaxPlayers;
+}
+void AGoGameStateBase::RefreshSessionAdvertising(FName SessionName)
+{
+	if (!HasAuthority()) return;
 
-	//~ Call update session
-	if (GoSubsystem) GoSubsystem->UpdateSession(*NewSessionSettings);
+	if (!SessionInterface.IsValid())
+	{
+		SessionInterface = EOSGo::GetSessionInterface();
+		if (!SessionInterface.IsValid()) return;
+	}
+
+	//~ Debounce: under churn the open slot count can flip many times before the update is sent.
+	DirtyAdvertisingSessions.Add(SessionName);
+	if (!GetWorldTimerManager().IsTimerActive(AdvertisingDebounceTimerHandle))
+	{
+		GetWorldTimerManager().SetTimer(AdvertisingDebounceTimerHandle, this, &ThisClass::ApplySessionAdvertising, FMath::Max(AdvertisingDebounceTime, UE_KINDA_SMALL_NUMBER), false);
+	}
 }
-void AGoGameStateBase::PlayerListChanged()
+void AGoGameStateBase::ApplySessionAdvertising()
 {
-	//~ UPDATE PLAYER LIST
-	PlayerList.Empty();
-	for (TObjectPtr<APlayerState> PlayerState : PlayerArray)
+	const TSet<FName> SessionNames = MoveTemp(DirtyAdvertisingSessions);
+	DirtyAdvertisingSessions.Reset();
+	if (!SessionInterface.IsValid() || !GoSubsystem) return;
+
+	for (const FName SessionName : SessionNames)
 	{
-		PlayerList.AddUnique(FName(PlayerState->GetPlayerName()));
+		const FOnlineSessionSettings* LiveSettings = SessionInterface->GetSessionSettings(SessionName);
+		if (!LiveSettings) continue;
+
+		const bool bShouldAdvertise = ShouldAdvertiseSession(SessionName);
+		if (LiveSettings->bShouldAdvertise == bShouldAdvertise) continue;
+
+		//~ Change only the advertising field of the live settings.
+		FOnlineSessionSettings NewSessionSettings = *LiveSettings;
+		NewSessionSettings.bShouldAdvertise = bShouldAdvertise;
+		UE_LOG(LogEOSGoSession, Log, TEXT("%s: %s"), *SessionName.ToString(), bShouldAdvertise ? TEXT("session has open slots, advertising it") : TEXT("session is full, it will stop advertising"));
+
+		//~ Call update session
+		GoSubsystem->UpdateSession(NewSessionSettings, SessionName);
 	}
-	//~ Broadcast the updated player list.
-	OnPlayerListChanged.Broadcast(PlayerList);
 }
-void AGoGameStateBase::OnRep_MatchStartedText() const
+void AGoGameStateBase::RemoveFromRoster(const FUniqueNetIdRepl& PlayerId)
 {
-	OnSessionStarted.Broadcast(true);
+	FGoPlayerRosterEntry Removed;
+	if (PlayerId.IsValid() && PlayerRoster.Remove(PlayerId, Removed))
+	{
+		HandleRosterEntryRemoved(Removed);
+		BroadcastPlayerListChanged();
+		RefreshSessionAdvertising(Removed.SessionName);
+	}
 }
-void AGoGameStateBase::OnRep_PlayerList() const
+void AGoGameStateBase::HandleRosterEntryAdded(const FGoPlayerRosterEntry& Entry)
 {
-	OnPlayerListChanged.Broadcast(PlayerList);
+	OnPlayerJoined.Broadcast(Entry);
 }
+void AGoGameStateBase::HandleRosterEntryRemoved(const FGoPlayerRosterEntry& Entry)
+{
+	OnPlayerLeft.Broadcast(Entry);
+}
+void AGoGameStateBase::HandleRosterEntryChanged(const FGoPlayerRosterEntry& Entry)
+{
+	OnPlayerRosterEntryChanged.Broadcast(Entry);
+}
+void AGoGameStateBase::HandleRosterReceived()
+{
+	BroadcastPlayerListChanged();
+}
+void AGoGameStateBase::BroadcastPlayerListChanged() const
+{
+	if (!OnPlayerListChanged.IsBound()) return;
 
+	TArray<FName> PlayerList;
+	PlayerList.Reserve(PlayerRoster.Entries.Num());
+	for (const FGoPlayerRosterEntry& Entry : PlayerRoster.Entries)
+	{
+		PlayerList.Add(FName(Entry.DisplayName));
+	}
+	//~ Broadcast the updated player list.
+	OnPlayerListChanged.Broadcast(PlayerList);
+}
+void AGoGameStateBase::OnRep_MatchStartedText() const
+{
+	OnSessionStarted.Broadcast(true);
+}
\ No newline at end of file
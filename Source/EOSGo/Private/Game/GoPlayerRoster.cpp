@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Game/GoPlayerRoster.h"
+#include "Algo/Count.h"
+#include "Game/GoGameStateBase.h"
+
+void FGoPlayerRosterEntry::PreReplicatedRemove(const FGoPlayerRoster& InRoster) const
+{
+	if (InRoster.Owner) InRoster.Owner->HandleRosterEntryRemoved(*this);
+}
+void FGoPlayerRosterEntry::PostReplicatedAdd(const FGoPlayerRoster& InRoster) const
+{
+	if (InRoster.Owner) InRoster.Owner->HandleRosterEntryAdded(*this);
+}
+void FGoPlayerRosterEntry::PostReplicatedChange(const FGoPlayerRoster& InRoster) const
+{
+	if (InRoster.Owner) InRoster.Owner->HandleRosterEntryChanged(*this);
+}
+
+void FGoPlayerRoster::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters) const
+{
+	if (Owner) Owner->HandleRosterReceived();
+}
+
+
+const FGoPlayerRosterEntry* FGoPlayerRoster::AddOrUpdate(const FUniqueNetIdRepl& PlayerId, const FString& DisplayName, FName SessionName, EGoPlayerRosterState State)
+{
+	if (FGoPlayerRosterEntry* Entry = Entries.FindByPredicate([&PlayerId](const FGoPlayerRosterEntry& It) { return It.PlayerId == PlayerId; }))
+	{
+		if (Entry->DisplayName == DisplayName && Entry->SessionName == SessionName && Entry->State == State) return nullptr;
+		Entry->DisplayName = DisplayName;
+		Entry->SessionName = SessionName;
+		Entry->State = State;
+		MarkItemDirty(*Entry);
+		return Entry;
+	}
+
+	FGoPlayerRosterEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.PlayerId = PlayerId;
+	Entry.DisplayName = DisplayName;
+	Entry.SessionName = SessionName;
+	Entry.State = State;
+	MarkItemDirty(Entry);
+	return &Entry;
+}
+
+bool FGoPlayerRoster::Remove(const FUniqueNetIdRepl& PlayerId, FGoPlayerRosterEntry& OutRemoved)
+{
+	const int32 Index = Entries.IndexOfByPredicate([&PlayerId](const FGoPlayerRosterEntry& It) { return It.PlayerId == PlayerId; });
+	if (Index == INDEX_NONE) return false;
+
+	OutRemoved = Entries[Index];
+	Entries.RemoveAtSwap(Index);
+	MarkArrayDirty();
+	return true;
+}
+
+TArray<const FGoPlayerRosterEntry*> FGoPlayerRoster::SetSessionStates(FName SessionName, EGoPlayerRosterState State)
+{
+	TArray<const FGoPlayerRosterEntry*> Changed;
+	for (FGoPlayerRosterEntry& Entry : Entries)
+	{
+		if (Entry.SessionName != SessionName || Entry.State == State) continue;
+		Entry.State = State;
+		MarkItemDirty(Entry);
+		Changed.Add(&Entry);
+	}
+	return Changed;
+}
+
+int32 FGoPlayerRoster::NumSessionEntries(FName SessionName) const
+{
+	return Algo::CountIf(Entries, [SessionName](const FGoPlayerRosterEntry& Entry) { return Entry.SessionName == SessionName; });
+}
\ No newline at end of file
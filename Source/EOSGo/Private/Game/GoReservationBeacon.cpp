@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Game/GoReservationBeacon.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Game/GoGameModeBase.h"
+#include "EOSGo.h"
+
+
+bool AGoReservationBeaconClient::RequestReservation(const FString& ConnectString, FName InSessionName)
+{
+	SessionName = InSessionName;
+
+	FURL ConnectUrl(nullptr, *ConnectString, TRAVEL_Absolute);
+	return InitClient(ConnectUrl);
+}
+void AGoReservationBeaconClient::OnConnected()
+{
+	Super::OnConnected();
+	ServerRequestReservation(SessionName);
+}
+void AGoReservationBeaconClient::OnFailure()
+{
+	UE_LOG(LogEOSGoSession, Verbose, TEXT("Reservation beacon could not reach the host"));
+	Super::OnFailure();
+	CompleteReservation(EGoSlotReservationResult::Unavailable, FString());
+
+	//~ Failures can be raised from inside InitClient, so the beacon goes away on the next tick.
+	GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::DestroyBeacon);
+}
+
+void AGoReservationBeaconClient::ServerRequestReservation_Implementation(FName RequestedSessionName)
+{
+	//~ One slot per connection, so a client can't hold a session's slots by repeating the request.
+	if (bHasRequestedReservation)
+	{
+		ClientReservationResponse(EGoSlotReservationResult::Full, FString());
+		return;
+	}
+	bHasRequestedReservation = true;
+
+	//~ The slot goes to the id the connection logged in with, never to one the client names.
+	const UNetConnection* Connection = GetNetConnection();
+	AGoGameModeBase* GoGameModeBase = GetWorld() ? GetWorld()->GetAuthGameMode<AGoGameModeBase>() : nullptr;
+	if (!GoGameModeBase || !Connection || !Connection->PlayerId.IsValid())
+	{
+		ClientReservationResponse(EGoSlotReservationResult::Unavailable, FString());
+		return;
+	}
+
+	FString Token;
+	const bool bWasGranted = GoGameModeBase->ReserveSlot(Connection->PlayerId, RequestedSessionName, Token);
+	ClientReservationResponse(bWasGranted ? EGoSlotReservationResult::Granted : EGoSlotReservationResult::Full, Token);
+}
+void AGoReservationBeaconClient::ClientReservationResponse_Implementation(EGoSlotReservationResult Result, const FString& Token)
+{
+	CompleteReservation(Result, Token);
+	DestroyBeacon();
+}
+void AGoReservationBeaconClient::CompleteReservation(EGoSlotReservationResult Result, const FString& Token)
+{
+	//~ Unbound first, so a failure raised while destroying the beacon doesn't report twice.
+	const FGoOnSlotReservationComplete Callback = OnReservationComplete;
+	OnReservationComplete.Unbind();
+	Callback.ExecuteIfBound(Result, Token);
+}
+
+
+AGoReservationBeaconHost::AGoReservationBeaconHost()
+{
+	ClientBeaconActorClass = AGoReservationBeaconClient::StaticClass();
+	BeaconTypeName = ClientBeaconActorClass->GetName();
+}
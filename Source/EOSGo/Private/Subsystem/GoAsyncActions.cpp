@@ -0,0 +1,188 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoAsyncActions.h"
+#include "Subsystem/GoSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+
+void UGoAsyncAction::Cancel()
+{
+	//~ Before Activate the request is never issued; after it, the subsystem answers through the request's callback.
+	bIsCancelled = true;
+	if (UGoSubsystem* Subsystem = GoSubsystem.Get(); Subsystem && RequestId != 0)
+	{
+		Subsystem->CancelRequest(RequestId);
+	}
+}
+void UGoAsyncAction::Setup(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	GoSubsystem = GameInstance ? GameInstance->GetSubsystem<UGoSubsystem>() : nullptr;
+	RegisterWithGameInstance(WorldContextObject);
+}
+UGoSubsystem* UGoAsyncAction::BeginRequest()
+{
+	return bIsCancelled ? nullptr : GoSubsystem.Get();
+}
+void UGoAsyncAction::Finish()
+{
+	RequestId = 0;
+	bIsFinished = true;
+	SetReadyToDestroy();
+}
+
+
+UGoRequestAsyncAction* UGoRequestAsyncAction::Create(const UObject* WorldContextObject, TFunction<int32(UGoSubsystem&, FGoOnRequestComplete&&)>&& InIssueRequest)
+{
+	UGoRequestAsyncAction* Action = NewObject<UGoRequestAsyncAction>();
+	Action->IssueRequest = MoveTemp(InIssueRequest);
+	Action->Setup(WorldContextObject);
+	return Action;
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoAutoLoginAsync(UObject* WorldContextObject)
+{
+	return Create(WorldContextObject, [](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete) { return Subsystem.GoAutoLogin(MoveTemp(OnComplete)); });
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoInteractiveLoginAsync(UObject* WorldContextObject)
+{
+	return Create(WorldContextObject, [](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete) { return Subsystem.GoInteractiveLogin(MoveTemp(OnComplete)); });
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoCreateSessionAsync(UObject* WorldContextObject, int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession)
+{
+	return Create(WorldContextObject, [=](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoCreateSession(NumberOfConnections, MatchType, ServerPrivateJoinId, bIsPrivateSession, NAME_GameSession, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoHostDedicatedSessionAsync(UObject* WorldContextObject, FName MatchType, int32 NumberOfConnections)
+{
+	return Create(WorldContextObject, [=](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoHostDedicatedSession(MatchType, NumberOfConnections, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoHostDedicatedLobbyAsync(UObject* WorldContextObject, FName MatchType, int32 NumberOfConnections)
+{
+	return Create(WorldContextObject, [=](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		FName SessionName;
+		return Subsystem.GoHostDedicatedLobby(MatchType, NumberOfConnections, MoveTemp(OnComplete), SessionName);
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoJoinSessionAsync(UObject* WorldContextObject, const FBlueprintSessionResult& SessionResult)
+{
+	return Create(WorldContextObject, [SearchResult = SessionResult.OnlineResult](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoJoinSession(SearchResult, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoJoinBestSessionAsync(UObject* WorldContextObject, const TArray<FBlueprintSessionResult>& SessionResults, FName PreferredMatchType)
+{
+	TArray<FOnlineSessionSearchResult> SearchResults;
+	SearchResults.Reserve(SessionResults.Num());
+	for (const FBlueprintSessionResult& SessionResult : SessionResults)
+	{
+		SearchResults.Add(SessionResult.OnlineResult);
+	}
+	return Create(WorldContextObject, [SearchResults = MoveTemp(SearchResults), PreferredMatchType](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoJoinBestSession(SearchResults, PreferredMatchType, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoFindAndJoinSessionAsync(UObject* WorldContextObject, int64 ServerJoinId, FName MatchType, int32 MinOpenSlots)
+{
+	return Create(WorldContextObject, [=](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoFindAndJoinSession(ServerJoinId, MatchType, UGoSubsystem::MakeJoinPredicate(MatchType, MinOpenSlots), FGoOnFindSessionsBatch(), MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoJoinSessionByCodeAsync(UObject* WorldContextObject, const FString& JoinCode)
+{
+	return Create(WorldContextObject, [JoinCode](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoJoinSessionByCode(JoinCode, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoStartSessionAsync(UObject* WorldContextObject, FName SessionName)
+{
+	return Create(WorldContextObject, [SessionName](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoStartSession(SessionName.IsNone() ? NAME_GameSession : SessionName, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoDestroySessionAsync(UObject* WorldContextObject, FName SessionName)
+{
+	return Create(WorldContextObject, [SessionName](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoDestroySession(SessionName.IsNone() ? NAME_GameSession : SessionName, MoveTemp(OnComplete));
+	});
+}
+UGoRequestAsyncAction* UGoRequestAsyncAction::GoQuickMatchAsync(UObject* WorldContextObject, FName MatchType, bool bSpeculativeHost)
+{
+	return Create(WorldContextObject, [=](UGoSubsystem& Subsystem, FGoOnRequestComplete&& OnComplete)
+	{
+		return Subsystem.GoQuickMatch(MatchType, bSpeculativeHost, MoveTemp(OnComplete));
+	});
+}
+void UGoRequestAsyncAction::Activate()
+{
+	UGoSubsystem* Subsystem = BeginRequest();
+	if (!Subsystem || !IssueRequest)
+	{
+		FGoRequestResult Result;
+		Result.bWasCancelled = bIsCancelled;
+		OnRequestComplete(Result);
+		return;
+	}
+
+	//~ The request may answer before it returns its id.
+	const int32 IssuedRequestId = IssueRequest(*Subsystem, FGoOnRequestComplete::CreateUObject(this, &ThisClass::OnRequestComplete));
+	if (!bIsFinished) RequestId = IssuedRequestId;
+}
+void UGoRequestAsyncAction::OnRequestComplete(const FGoRequestResult& Result)
+{
+	const FGoOnAsyncRequestComplete& Pin = Result.bWasCancelled ? OnCancelled : Result.bWasSuccessful ? OnSuccess : OnFailure;
+	Pin.Broadcast(Result.RequestId, Result.SessionName, Result.Detail);
+	Finish();
+}
+
+
+UGoFindSessionsAsyncAction* UGoFindSessionsAsyncAction::GoFindSessionsAsync(UObject* WorldContextObject, int64 ServerJoinId, FName MatchType)
+{
+	UGoFindSessionsAsyncAction* Action = NewObject<UGoFindSessionsAsyncAction>();
+	Action->ServerJoinId = ServerJoinId;
+	Action->MatchType = MatchType;
+	Action->Setup(WorldContextObject);
+	return Action;
+}
+void UGoFindSessionsAsyncAction::Activate()
+{
+	UGoSubsystem* Subsystem = BeginRequest();
+	if (!Subsystem)
+	{
+		FGoRequestResult Result;
+		Result.bWasCancelled = bIsCancelled;
+		OnRequestComplete(Result, TArray<FOnlineSessionSearchResult>());
+		return;
+	}
+
+	//~ The request may answer before it returns its id.
+	const int32 IssuedRequestId = Subsystem->GoFindSessions(ServerJoinId, MatchType, FGoOnFindSessionsRequestComplete::CreateUObject(this, &ThisClass::OnRequestComplete));
+	if (!bIsFinished) RequestId = IssuedRequestId;
+}
+void UGoFindSessionsAsyncAction::OnRequestComplete(const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	TArray<FBlueprintSessionResult> BlueprintResults;
+	BlueprintResults.Reserve(SessionResults.Num());
+	for (const FOnlineSessionSearchResult& SessionResult : SessionResults)
+	{
+		BlueprintResults.AddDefaulted_GetRef().OnlineResult = SessionResult;
+	}
+
+	const FGoOnAsyncFindSessionsComplete& Pin = Result.bWasCancelled ? OnCancelled : Result.bWasSuccessful ? OnSuccess : OnFailure;
+	Pin.Broadcast(Result.RequestId, BlueprintResults);
+	Finish();
+}
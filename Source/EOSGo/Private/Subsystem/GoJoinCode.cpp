@@ -0,0 +1,143 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoJoinCode.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	const TCHAR* Alphabet = TEXT("0123456789ABCDEFGHJKMNPQRSTVWXYZ");
+	constexpr int32 GroupLength = 4;
+
+	//~ First symbol of a code: how the session id was packed. EOS ids are hex, so they take half the symbols text would.
+	enum class EGoJoinCodeKind : uint8
+	{
+		LowerHex,
+		UpperHex,
+		Text,
+		Count
+	};
+
+	int32 GetSymbolValue(TCHAR Symbol)
+	{
+		//~ Letters that read like digits are taken as those digits.
+		Symbol = FChar::ToUpper(Symbol);
+		if (Symbol == TEXT('O')) Symbol = TEXT('0');
+		else if (Symbol == TEXT('I') || Symbol == TEXT('L')) Symbol = TEXT('1');
+
+		const TCHAR* Found = Symbol ? FCString::Strchr(Alphabet, Symbol) : nullptr;
+		return Found ? static_cast<int32>(Found - Alphabet) : INDEX_NONE;
+	}
+	bool IsHex(const FString& String, bool bUpperCase)
+	{
+		if (String.IsEmpty() || String.Len() % 2 != 0) return false;
+		for (const TCHAR Char : String)
+		{
+			const bool bIsLetter = bUpperCase ? Char >= TEXT('A') && Char <= TEXT('F') : Char >= TEXT('a') && Char <= TEXT('f');
+			if (!FChar::IsDigit(Char) && !bIsLetter) return false;
+		}
+		return true;
+	}
+	uint8 GetCheckSymbol(const TArray<uint8>& Symbols)
+	{
+		return static_cast<uint8>(FCrc::MemCrc32(Symbols.GetData(), Symbols.Num()) % 32);
+	}
+}
+
+FString FGoJoinCode::Encode(const FString& SessionId)
+{
+	if (SessionId.IsEmpty()) return FString();
+
+	TArray<uint8> Bytes;
+	EGoJoinCodeKind Kind = EGoJoinCodeKind::Text;
+	if (IsHex(SessionId, false) || IsHex(SessionId, true))
+	{
+		Kind = IsHex(SessionId, false) ? EGoJoinCodeKind::LowerHex : EGoJoinCodeKind::UpperHex;
+		Bytes.SetNumUninitialized(SessionId.Len() / 2);
+		HexToBytes(SessionId, Bytes.GetData());
+	}
+	else
+	{
+		const FTCHARToUTF8 Utf8(*SessionId);
+		Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	//~ Five bits per symbol, the last one zero padded.
+	TArray<uint8> Symbols;
+	Symbols.Reserve(Bytes.Num() * 8 / 5 + 3);
+	Symbols.Add(static_cast<uint8>(Kind));
+	uint32 Buffer = 0;
+	int32 NumBits = 0;
+	for (const uint8 Byte : Bytes)
+	{
+		Buffer = (Buffer << 8) | Byte;
+		NumBits += 8;
+		while (NumBits >= 5)
+		{
+			NumBits -= 5;
+			Symbols.Add(static_cast<uint8>((Buffer >> NumBits) & 31));
+		}
+	}
+	if (NumBits > 0) Symbols.Add(static_cast<uint8>((Buffer << (5 - NumBits)) & 31));
+	Symbols.Add(GetCheckSymbol(Symbols));
+
+	FString JoinCode;
+	JoinCode.Reserve(Symbols.Num() + Symbols.Num() / GroupLength);
+	for (int32 Index = 0; Index < Symbols.Num(); ++Index)
+	{
+		if (Index > 0 && Index % GroupLength == 0) JoinCode.AppendChar(TEXT('-'));
+		JoinCode.AppendChar(Alphabet[Symbols[Index]]);
+	}
+	return JoinCode;
+}
+
+bool FGoJoinCode::Decode(const FString& JoinCode, FString& OutSessionId)
+{
+	TArray<uint8> Symbols;
+	for (const TCHAR Char : JoinCode)
+	{
+		if (Char == TEXT('-') || FChar::IsWhitespace(Char)) continue;
+		const int32 Value = GetSymbolValue(Char);
+		if (Value == INDEX_NONE) return false;
+		Symbols.Add(static_cast<uint8>(Value));
+	}
+
+	//~ Kind, at least one data symbol and the check symbol.
+	if (Symbols.Num() < 3) return false;
+	const uint8 CheckSymbol = Symbols.Last();
+	Symbols.RemoveAt(Symbols.Num() - 1);
+	if (GetCheckSymbol(Symbols) != CheckSymbol || Symbols[0] >= static_cast<uint8>(EGoJoinCodeKind::Count)) return false;
+	const EGoJoinCodeKind Kind = static_cast<EGoJoinCodeKind>(Symbols[0]);
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(Symbols.Num() * 5 / 8);
+	uint32 Buffer = 0;
+	int32 NumBits = 0;
+	for (int32 Index = 1; Index < Symbols.Num(); ++Index)
+	{
+		Buffer = (Buffer << 5) | Symbols[Index];
+		NumBits += 5;
+		if (NumBits >= 8)
+		{
+			NumBits -= 8;
+			Bytes.Add(static_cast<uint8>((Buffer >> NumBits) & 0xFF));
+		}
+	}
+	//~ Only the zero padding of the last symbol may be left over.
+	if (NumBits >= 5 || (Buffer & ((1u << NumBits) - 1)) != 0 || Bytes.IsEmpty()) return false;
+
+	switch (Kind)
+	{
+	case EGoJoinCodeKind::LowerHex:
+		OutSessionId = BytesToHexLower(Bytes.GetData(), Bytes.Num());
+		return true;
+	case EGoJoinCodeKind::UpperHex:
+		OutSessionId = BytesToHex(Bytes.GetData(), Bytes.Num());
+		return true;
+	default:
+		{
+			const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+			OutSessionId = FString(Text.Length(), Text.Get());
+			return true;
+		}
+	}
+}
@@ -0,0 +1,464 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoLoadHarness.h"
+#include "Subsystem/GoMockOnlineBackend.h"
+#include "Subsystem/GoSubsystem.h"
+#include "Game/GoGameModeBase.h"
+#include "Game/GoGameStateBase.h"
+#include "EOSGo.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+UGoLoadHarness* UGoLoadHarness::ActiveHarness = nullptr;
+
+namespace
+{
+	//~ Extra time the host waits for clients to write their last results before terminating them.
+	constexpr float ClientShutdownGrace = 5.f;
+	//~ Time between rejoin attempts after a failed search, join or travel.
+	constexpr float RetryDelay = 1.f;
+	//~ Churn: stay time range, and time before rejoining.
+	constexpr float ChurnMinStay = 2.f;
+	constexpr float ChurnMaxStay = 10.f;
+	constexpr float ChurnRejoinDelay = 1.f;
+	//~ Burst: every client leaves at each multiple of this wall-clock period.
+	constexpr int64 BurstPeriodSeconds = 15;
+
+	const TCHAR* GetPatternName(EGoLoadPattern Pattern)
+	{
+		switch (Pattern)
+		{
+		case EGoLoadPattern::Churn: return TEXT("churn");
+		case EGoLoadPattern::Burst: return TEXT("burst");
+		default: return TEXT("fill");
+		}
+	}
+
+	//~ The harness launches processes; it is a development tool and never reachable in Shipping builds.
+#if !UE_BUILD_SHIPPING
+	EGoLoadPattern ParsePattern(const FString& Name)
+	{
+		if (Name == TEXT("churn")) return EGoLoadPattern::Churn;
+		if (Name == TEXT("burst")) return EGoLoadPattern::Burst;
+		return EGoLoadPattern::Fill;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartLoadCommand(
+		TEXT("EOSGo.Load.Start"),
+		TEXT("EOSGo.Load.Start [Clients=8] [fill|churn|burst] [Seconds=60]: launches headless clients against this listen server and reports server load."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const int32 NumClients = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8;
+			const EGoLoadPattern Pattern = Args.Num() > 1 ? ParsePattern(Args[1]) : EGoLoadPattern::Fill;
+			const float Seconds = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 60.f;
+			UGoLoadHarness::Start(World, NumClients, Pattern, Seconds);
+		}));
+
+	FAutoConsoleCommand StopLoadCommand(
+		TEXT("EOSGo.Load.Stop"),
+		TEXT("Stops the running load harness, terminating its clients, and logs the report."),
+		FConsoleCommandDelegate::CreateLambda([]() { UGoLoadHarness::Stop(); }));
+#endif
+
+	uint64 GetNetBytesSent(const UWorld* World)
+	{
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		return NetDriver ? static_cast<uint64>(NetDriver->OutTotalBytes) : 0;
+	}
+}
+
+
+bool UGoLoadHarness::Start(UWorld* InWorld, int32 NumClients, EGoLoadPattern InPattern, float Seconds)
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	AGoGameModeBase* GameMode = InWorld ? InWorld->GetAuthGameMode<AGoGameModeBase>() : nullptr;
+	if (IsRunning() || !GameMode || InWorld->GetNetMode() != NM_ListenServer || NumClients <= 0 || Seconds <= 0.f)
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo.Load.Start needs a listening AGoGameModeBase, clients and a duration"));
+		return false;
+	}
+
+	UGoLoadHarness* Harness = NewObject<UGoLoadHarness>(GetTransientPackage());
+	Harness->AddToRoot();
+	ActiveHarness = Harness;
+	Harness->World = InWorld;
+	Harness->Pattern = InPattern;
+	Harness->StartTime = FPlatformTime::Seconds();
+	Harness->StopTime = Harness->StartTime + Seconds + ClientShutdownGrace;
+	if (const AGoGameStateBase* GameState = InWorld->GetGameState<AGoGameStateBase>()) Harness->RosterBytesAtStart = GameState->GetPlayerRosterBytesSent();
+	Harness->NetBytesAtStart = GetNetBytesSent(InWorld);
+
+	//~ Bind callbacks.
+	Harness->PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(Harness, &ThisClass::OnPostLogin);
+	Harness->RegisterPlayerResultHandle = GameMode->GoOnRegisterPlayerResult.AddUObject(Harness, &ThisClass::OnRegisterPlayerResult);
+	Harness->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Harness, &ThisClass::Tick));
+
+	if (!Harness->LaunchClients(InWorld, NumClients, InPattern, Seconds))
+	{
+		Stop();
+		return false;
+	}
+	UE_LOG(LogEOSGo, Display, TEXT("EOSGo load harness started: %d %s client(s) for %.0fs"), Harness->ClientProcesses.Num(), GetPatternName(InPattern), Seconds);
+	return true;
+#endif
+}
+bool UGoLoadHarness::LaunchClients(UWorld* InWorld, int32 NumClients, EGoLoadPattern InPattern, float Seconds)
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	ReportDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("EOSGoLoad") / FDateTime::Now().ToString());
+	IFileManager::Get().MakeDirectory(*ReportDirectory, true);
+
+	//~ Clients use the host's backend: the mock, or the Null subsystem when the host runs on it.
+	FString BackendArgs;
+#if !UE_BUILD_SHIPPING
+	if (FGoMockOnlineBackend::IsEnabled())
+	{
+		BackendArgs = TEXT(" -EOSGoMock");
+	}
+	else
+#endif
+	if (const IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get(); Subsystem && Subsystem->GetSubsystemName() == NULL_SUBSYSTEM)
+	{
+		BackendArgs = TEXT(" -ini:Engine:[OnlineSubsystem]:DefaultPlatformService=Null");
+	}
+	const FString ProjectArg = FPaths::IsProjectFilePathSet() ? FString::Printf(TEXT("\"%s\" "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath())) : FString();
+	const FString HostAddress = FString::Printf(TEXT("127.0.0.1:%d"), InWorld->URL.Port);
+
+	for (int32 Index = 0; Index < NumClients; ++Index)
+	{
+		const FString ClientArgs = FString::Printf(
+			TEXT("%s-game -nullrhi -nosound -nosplash -unattended -log -abslog=\"%s\" -EOSGoLoadClient=%s -EOSGoLoadClientId=%d -EOSGoLoadHost=%s -EOSGoLoadReport=\"%s\" -EOSGoLoadSeconds=%.0f%s"),
+			*ProjectArg, *(ReportDirectory / FString::Printf(TEXT("client_%d.log"), Index)), GetPatternName(InPattern), Index,
+			*HostAddress, *ReportDirectory, Seconds, *BackendArgs);
+
+		FProcHandle Process = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *ClientArgs, true, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Process.IsValid())
+		{
+			UE_LOG(LogEOSGo, Warning, TEXT("Load client %d could not be launched"), Index);
+			continue;
+		}
+		ClientProcesses.Add(Process);
+	}
+	return !ClientProcesses.IsEmpty();
+#endif
+}
+void UGoLoadHarness::Stop()
+{
+	UGoLoadHarness* Harness = ActiveHarness;
+	if (!Harness) return;
+	ActiveHarness = nullptr;
+
+	for (FProcHandle& Process : Harness->ClientProcesses)
+	{
+		if (FPlatformProcess::IsProcRunning(Process)) FPlatformProcess::TerminateProc(Process);
+		FPlatformProcess::CloseProc(Process);
+	}
+	Harness->ClientProcesses.Reset();
+
+	FGameModeEvents::GameModePostLoginEvent.Remove(Harness->PostLoginHandle);
+	if (AGoGameModeBase* GameMode = Harness->World.IsValid() ? Harness->World->GetAuthGameMode<AGoGameModeBase>() : nullptr)
+	{
+		GameMode->GoOnRegisterPlayerResult.Remove(Harness->RegisterPlayerResultHandle);
+	}
+	FTSTicker::GetCoreTicker().RemoveTicker(Harness->TickerHandle);
+
+	Harness->Report();
+	Harness->RemoveFromRoot();
+}
+
+
+bool UGoLoadHarness::Tick(float DeltaTime)
+{
+	//~ The core ticker runs once per engine frame, so its delta is the server frame time.
+	FrameTime.Add(DeltaTime * 1000.0);
+	if (const UWorld* HostWorld = World.Get())
+	{
+		if (const AGameStateBase* GameState = HostWorld->GetGameState()) PeakPlayers = FMath::Max(PeakPlayers, GameState->PlayerArray.Num());
+	}
+
+	if (FPlatformTime::Seconds() >= StopTime || !World.IsValid())
+	{
+		//~ Stop removes this ticker; returning true keeps the removal the only one.
+		Stop();
+	}
+	return true;
+}
+void UGoLoadHarness::OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	const APlayerState* PlayerState = NewPlayer ? NewPlayer->GetPlayerState<APlayerState>() : nullptr;
+	if (!PlayerState || !PlayerState->GetUniqueId().IsValid()) return;
+
+	LoginTimes.Add(PlayerState->GetUniqueId().ToString(), FPlatformTime::Seconds());
+}
+void UGoLoadHarness::OnRegisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess)
+{
+	if (!bWasSuccess)
+	{
+		++FailedRegistrations;
+		return;
+	}
+	++Registrations;
+
+	double LoginTime = 0.0;
+	if (LoginTimes.RemoveAndCopyValue(PlayerId->ToString(), LoginTime))
+	{
+		LoginToRegistered.Add((FPlatformTime::Seconds() - LoginTime) * 1000.0);
+	}
+}
+
+
+void UGoLoadHarness::Report()
+{
+	const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_KINDA_SMALL_NUMBER);
+	const AGoGameStateBase* GameState = World.IsValid() ? World->GetGameState<AGoGameStateBase>() : nullptr;
+	const uint64 RosterBytes = GameState ? GameState->GetPlayerRosterBytesSent() - RosterBytesAtStart : 0;
+	const uint64 NetBytes = GetNetBytesSent(World.Get()) - NetBytesAtStart;
+
+	//~ Client results: one "TimeToJoinMs,bWasSuccess" line per join attempt.
+	FGoLatencyHistogram TimeToJoin;
+	uint32 FailedJoins = 0;
+	TArray<FString> ClientReports;
+	IFileManager::Get().FindFiles(ClientReports, *(ReportDirectory / TEXT("*.csv")), true, false);
+	for (const FString& ClientReport : ClientReports)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *(ReportDirectory / ClientReport));
+		for (const FString& Line : Lines)
+		{
+			FString Milliseconds, bWasSuccess;
+			if (!Line.Split(TEXT(","), &Milliseconds, &bWasSuccess)) continue;
+			if (bWasSuccess.TrimStartAndEnd() == TEXT("1")) TimeToJoin.Add(FCString::Atod(*Milliseconds));
+			else ++FailedJoins;
+		}
+	}
+
+	auto LogHistogram = [](const TCHAR* Name, const FGoLatencyHistogram& Histogram)
+	{
+		if (Histogram.Count == 0) return;
+		UE_LOG(LogEOSGo, Display, TEXT("  %-18s n=%llu p50=%.1f p95=%.1f p99=%.1f max=%.1f mean=%.1f"),
+			Name, Histogram.Count, Histogram.GetPercentile(0.50f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f),
+			Histogram.MaxMs, Histogram.TotalMs / Histogram.Count);
+	};
+	UE_LOG(LogEOSGo, Display, TEXT("EOSGo load harness (%s, %.0fs, peak %d player(s)), reports in %s:"), GetPatternName(Pattern), Elapsed, PeakPlayers, *ReportDirectory);
+	UE_LOG(LogEOSGo, Display, TEXT("  Registrations      %u ok, %u failed, %.2f/s"), Registrations, FailedRegistrations, Registrations / Elapsed);
+	UE_LOG(LogEOSGo, Display, TEXT("  PlayerList bytes   %llu (%.1f B/s), %.1f%% of %llu bytes sent"),
+		RosterBytes, RosterBytes / Elapsed, NetBytes > 0 ? 100.0 * RosterBytes / NetBytes : 0.0, NetBytes);
+	UE_LOG(LogEOSGo, Display, TEXT("  Failed joins       %u"), FailedJoins);
+	UE_LOG(LogEOSGo, Display, TEXT("  Latency (ms):"));
+	LogHistogram(TEXT("FrameTime"), FrameTime);
+	LogHistogram(TEXT("LoginToRegistered"), LoginToRegistered);
+	LogHistogram(TEXT("TimeToJoin"), TimeToJoin);
+}
+
+
+void UGoLoadClient::OnStartGameInstance(UGameInstance* InGameInstance)
+{
+#if !UE_BUILD_SHIPPING
+	FString PatternName;
+	if (!InGameInstance || !FParse::Value(FCommandLine::Get(), TEXT("-EOSGoLoadClient="), PatternName)) return;
+
+	UGoSubsystem* Subsystem = InGameInstance->GetSubsystem<UGoSubsystem>();
+	if (!Subsystem) return;
+
+	UGoLoadClient* Client = NewObject<UGoLoadClient>(InGameInstance);
+	Client->GameInstance = InGameInstance;
+	Client->GoSubsystem = Subsystem;
+	Client->Pattern = ParsePattern(PatternName);
+	FParse::Value(FCommandLine::Get(), TEXT("-EOSGoLoadClientId="), Client->ClientId);
+	FParse::Value(FCommandLine::Get(), TEXT("-EOSGoLoadHost="), Client->HostAddress);
+	FString ReportDirectory;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-EOSGoLoadReport="), ReportDirectory))
+	{
+		Client->ReportFile = ReportDirectory / FString::Printf(TEXT("client_%d.csv"), Client->ClientId);
+	}
+	//~ Kept alive by the game instance, which outlives every map the client travels through.
+	InGameInstance->RegisterReferencedObject(Client);
+
+	float Seconds = 0.f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-EOSGoLoadSeconds="), Seconds) && Seconds > 0.f)
+	{
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float) { FPlatformMisc::RequestExit(false); return false; }), Seconds);
+	}
+
+	//~ Bind callbacks.
+	Subsystem->GoOnLoginComplete.AddDynamic(Client, &ThisClass::OnLoginComplete);
+	Subsystem->GoOnFindSessionsComplete.AddUObject(Client, &ThisClass::OnFindSessionsComplete);
+	Subsystem->GoOnJoinSessionComplete.AddUObject(Client, &ThisClass::OnJoinSessionComplete);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(Client, &ThisClass::OnPostLoadMap);
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().AddUObject(Client, &ThisClass::OnTravelFailure);
+		GEngine->OnNetworkFailure().AddUObject(Client, &ThisClass::OnNetworkFailure);
+	}
+
+	//~ The startup login is usually running already; otherwise start one.
+	if (Subsystem->IsPlayerLoggedIn())
+	{
+		Client->Search();
+	}
+	else if (!Subsystem->IsLoginInProgress())
+	{
+		Subsystem->GoAutoLogin();
+	}
+#endif
+}
+
+
+void UGoLoadClient::OnLoginComplete(FName Username)
+{
+	if (State != EState::LoggingIn) return;
+
+	if (GoSubsystem->IsPlayerLoggedIn()) Search();
+	else Schedule(RetryDelay, &ThisClass::Search);
+}
+void UGoLoadClient::Search()
+{
+	if (State == EState::LoggingIn && !GoSubsystem->IsPlayerLoggedIn())
+	{
+		GoSubsystem->GoAutoLogin();
+		return;
+	}
+
+	//~ SEARCH - time-to-join runs from here until the host's map is loaded.
+	State = EState::Searching;
+	JoinStartTime = FPlatformTime::Seconds();
+	GoSubsystem->InvalidateSessionSearchCache();
+	GoSubsystem->GoFindSessions(0);
+}
+void UGoLoadClient::OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
+{
+	if (State != EState::Searching) return;
+
+	if (!bWasSuccessful || SessionResults.IsEmpty())
+	{
+		FailJoin();
+		return;
+	}
+
+	//~ JOIN
+	State = EState::Joining;
+	GoSubsystem->GoJoinBestSession(SessionResults);
+}
+void UGoLoadClient::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (State != EState::Joining) return;
+
+	if (Result != EOnJoinSessionCompleteResult::Success)
+	{
+		FailJoin();
+		return;
+	}
+
+	//~ TRAVEL - to the harness host when it is known (mock sessions all resolve to the default port).
+	FString ConnectionInfo = HostAddress;
+	if (ConnectionInfo.IsEmpty())
+	{
+		GoSubsystem->GetJoinedSessionTravelUrl(ConnectionInfo);
+	}
+	APlayerController* PlayerController = GameInstance->GetFirstLocalPlayerController();
+	if (ConnectionInfo.IsEmpty() || !PlayerController)
+	{
+		FailJoin();
+		return;
+	}
+	State = EState::Traveling;
+	PlayerController->ClientTravel(ConnectionInfo, TRAVEL_Absolute);
+}
+void UGoLoadClient::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (State != EState::Traveling || !LoadedWorld || LoadedWorld->GetNetMode() != NM_Client) return;
+
+	RecordJoin(true);
+	State = EState::Connected;
+	switch (Pattern)
+	{
+	case EGoLoadPattern::Churn:
+		Schedule(FMath::FRandRange(ChurnMinStay, ChurnMaxStay), &ThisClass::Leave);
+		break;
+	case EGoLoadPattern::Burst:
+	{
+		//~ Line up with the other clients on the shared wall clock.
+		const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+		Schedule(static_cast<float>(BurstPeriodSeconds - Now % BurstPeriodSeconds), &ThisClass::Leave);
+		break;
+	}
+	default:
+		break;
+	}
+}
+void UGoLoadClient::OnTravelFailure(UWorld* FailedWorld, ETravelFailure::Type FailureType, const FString& Error)
+{
+	if (State == EState::Traveling) FailJoin();
+}
+void UGoLoadClient::OnNetworkFailure(UWorld* FailedWorld, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& Error)
+{
+	if (State == EState::Traveling)
+	{
+		FailJoin();
+		return;
+	}
+	//~ Dropped by the host: rejoin like after a leave.
+	if (State == EState::Connected)
+	{
+		State = EState::Waiting;
+		GoSubsystem->GoDestroySession();
+		ScheduleSearch(RetryDelay);
+	}
+}
+
+
+void UGoLoadClient::Leave()
+{
+	if (State != EState::Connected) return;
+
+	State = EState::Waiting;
+	GoSubsystem->GoDestroySession();
+	GameInstance->ReturnToMainMenu();
+	ScheduleSearch(Pattern == EGoLoadPattern::Burst ? 0.f : ChurnRejoinDelay);
+}
+void UGoLoadClient::FailJoin()
+{
+	RecordJoin(false);
+	State = EState::Waiting;
+	ScheduleSearch(RetryDelay);
+}
+void UGoLoadClient::RecordJoin(bool bWasSuccess)
+{
+	const double Milliseconds = (FPlatformTime::Seconds() - JoinStartTime) * 1000.0;
+	UE_LOG(LogEOSGo, Log, TEXT("Load client %d %s in %.1fms"), ClientId, bWasSuccess ? TEXT("joined") : TEXT("failed to join"), Milliseconds);
+	if (ReportFile.IsEmpty()) return;
+
+	FFileHelper::SaveStringToFile(FString::Printf(TEXT("%.3f,%d\n"), Milliseconds, bWasSuccess ? 1 : 0), *ReportFile,
+		FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+void UGoLoadClient::ScheduleSearch(float Delay)
+{
+	Schedule(Delay, &ThisClass::Search);
+}
+void UGoLoadClient::Schedule(float Delay, void (UGoLoadClient::*Step)())
+{
+	//~ The core ticker keeps running across map travel, unlike world timers. A newer schedule supersedes older ones.
+	const uint32 Serial = ++StepSerial;
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Serial, Step](float)
+	{
+		if (Serial == StepSerial) (this->*Step)();
+		return false;
+	}), FMath::Max(Delay, 0.f));
+}
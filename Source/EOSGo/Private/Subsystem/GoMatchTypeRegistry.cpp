@@ -0,0 +1,51 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoMatchTypeRegistry.h"
+#include "EOSGo.h"
+#include "OnlineSessionSettings.h"
+#include "Subsystem/GoSessionAttributes.h"
+
+void FGoMatchTypeRegistry::Build(const TArray<FGoMatchTypeDefinition>& Definitions)
+{
+	MatchTypes.Empty(Definitions.Num());
+	for (const FGoMatchTypeDefinition& Definition : Definitions)
+	{
+		if (Definition.Name.IsNone() || Definition.MaxPlayers <= 0)
+		{
+			UE_LOG(LogEOSGo, Warning, TEXT("Ignoring invalid match type definition: %s"), *Definition.Name.ToString());
+			continue;
+		}
+
+		TSharedRef<FOnlineSessionSettings> Template = MakeSettingsTemplate(Definition.Name, Definition.MaxPlayers);
+		for (const TPair<FName, FString>& Attribute : Definition.AdvertisedAttributes)
+		{
+			Template->Set(Attribute.Key, Attribute.Value, EOnlineDataAdvertisementType::ViaOnlineService);
+		}
+
+		FGoMatchType& MatchType = MatchTypes.Add(Definition.Name);
+		MatchType.Definition = Definition;
+		MatchType.SettingsTemplate = Template;
+	}
+}
+
+TSharedRef<FOnlineSessionSettings> FGoMatchTypeRegistry::MakeSettingsTemplate(FName MatchType, int32 MaxPlayers)
+{
+	//~ Set session settings.
+	TSharedRef<FOnlineSessionSettings> SessionSettings = MakeShared<FOnlineSessionSettings>();
+	SessionSettings->bIsDedicated = false;
+	SessionSettings->bIsLANMatch = false;
+	SessionSettings->NumPublicConnections = MaxPlayers;
+	SessionSettings->NumPrivateConnections = 0;
+	SessionSettings->bUsesPresence = true;
+	SessionSettings->bAllowJoinViaPresence = true;
+	SessionSettings->bAllowJoinViaPresenceFriendsOnly = true;
+	SessionSettings->bAllowInvites = true;
+	SessionSettings->bAllowJoinInProgress = true;
+	SessionSettings->bUseLobbiesIfAvailable = false;
+	SessionSettings->bUseLobbiesVoiceChatIfAvailable = false;
+	SessionSettings->bShouldAdvertise = true;
+	SessionSettings->bUsesStats = true;
+	SessionSettings->BuildUniqueId = 1;
+	EOSGo::SessionAttributes::MatchType.Set(*SessionSettings, MatchType.ToString());
+	return SessionSettings;
+}
\ No newline at end of file
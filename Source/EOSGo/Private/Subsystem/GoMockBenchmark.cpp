@@ -0,0 +1,308 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoMockBenchmark.h"
+#include "Subsystem/GoMockOnlineBackend.h"
+#include "Subsystem/GoSubsystem.h"
+#include "Game/GoGameModeBase.h"
+#include "EOSGo.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "UObject/Package.h"
+
+UGoMockBenchmark* UGoMockBenchmark::ActiveBenchmark = nullptr;
+
+namespace
+{
+#if !UE_BUILD_SHIPPING
+	FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("EOSGo.Mock.Benchmark"),
+		TEXT("EOSGo.Mock.Benchmark [Iterations=20] [BurstSize=32] [-exit]: runs the session pipeline and a registration burst against the mock backend and logs per-stage latency."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			int32 Iterations = 20;
+			int32 BurstSize = 32;
+			bool bExitWhenDone = false;
+			int32 NumberArg = 0;
+			for (const FString& Arg : Args)
+			{
+				if (Arg == TEXT("-exit")) bExitWhenDone = true;
+				else if (NumberArg++ == 0) Iterations = FCString::Atoi(*Arg);
+				else BurstSize = FCString::Atoi(*Arg);
+			}
+			UGoMockBenchmark::Start(World, Iterations, BurstSize, bExitWhenDone);
+		}));
+#endif
+
+	//~ Stages that haven't completed by then are recorded as failed and end the benchmark.
+	constexpr float StageTimeoutSeconds = 30.f;
+}
+
+
+bool UGoMockBenchmark::Start(UWorld* World, int32 Iterations, int32 BurstSize, bool bExitWhenDone)
+{
+#if UE_BUILD_SHIPPING
+	//~ Shipping builds have no mock backend.
+	return false;
+#else
+	//~ Never benchmark against the live backend.
+	if (!FGoMockOnlineBackend::IsEnabled())
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo.Mock.Benchmark needs the mock backend (-EOSGoMock)"));
+		return false;
+	}
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UGoSubsystem* GoSubsystem = GameInstance ? GameInstance->GetSubsystem<UGoSubsystem>() : nullptr;
+	if (IsRunning() || !GoSubsystem || Iterations <= 0)
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo.Mock.Benchmark could not be started"));
+		return false;
+	}
+
+	UGoMockBenchmark* Benchmark = NewObject<UGoMockBenchmark>(GetTransientPackage());
+	Benchmark->AddToRoot();
+	ActiveBenchmark = Benchmark;
+	Benchmark->GoSubsystem = GoSubsystem;
+	Benchmark->GoGameModeBase = World->GetAuthGameMode<AGoGameModeBase>();
+	Benchmark->IterationsLeft = Iterations;
+	Benchmark->BurstSize = Benchmark->GoGameModeBase.IsValid() ? FMath::Max(BurstSize, 0) : 0;
+	Benchmark->bExitWhenDone = bExitWhenDone;
+
+	//~ Bind session callbacks. Logins are followed through their request, which also answers when they fail.
+	GoSubsystem->GoOnCreateSessionComplete.AddDynamic(Benchmark, &ThisClass::OnCreateSessionComplete);
+	Benchmark->FindSessionsHandle = GoSubsystem->GoOnFindSessionsComplete.AddUObject(Benchmark, &ThisClass::OnFindSessionsComplete);
+	Benchmark->JoinSessionHandle = GoSubsystem->GoOnJoinSessionComplete.AddUObject(Benchmark, &ThisClass::OnJoinSessionComplete);
+	GoSubsystem->GoOnStartSessionComplete.AddDynamic(Benchmark, &ThisClass::OnStartSessionComplete);
+	GoSubsystem->GoOnDestroySessionComplete.AddDynamic(Benchmark, &ThisClass::OnDestroySessionComplete);
+	if (AGoGameModeBase* GameMode = Benchmark->GoGameModeBase.Get())
+	{
+		Benchmark->RegisterPlayerResultHandle = GameMode->GoOnRegisterPlayerResult.AddUObject(Benchmark, &ThisClass::OnRegisterPlayerResult);
+		Benchmark->UnregisterPlayerResultHandle = GameMode->GoOnUnregisterPlayerResult.AddUObject(Benchmark, &ThisClass::OnUnregisterPlayerResult);
+	}
+
+	//~ Burst players are created once so every iteration registers the same ids.
+	const IOnlineIdentityPtr Identity = EOSGo::GetIdentityInterface();
+	for (int32 Index = 0; Identity && Index < Benchmark->BurstSize; ++Index)
+	{
+		if (const FUniqueNetIdPtr PlayerId = Identity->CreateUniquePlayerId(FString::Printf(TEXT("MockPlayer_%d"), Index)))
+		{
+			Benchmark->BurstPlayers.Add(PlayerId.ToSharedRef());
+		}
+	}
+
+	UE_LOG(LogEOSGo, Display, TEXT("EOSGo mock benchmark started: %d iteration(s), burst of %d player(s)"), Iterations, Benchmark->BurstPlayers.Num());
+	FGoOperationMetrics::Get().Reset();
+	Benchmark->StageTimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Benchmark, &ThisClass::CheckStageTimeout), 1.f);
+	Benchmark->StartIteration();
+	return true;
+#endif
+}
+
+
+FString UGoMockBenchmark::GetStageRegionName(EGoOnlineOperation Stage)
+{
+	return TEXT("EOSGo.Mock.") + StaticEnum<EGoOnlineOperation>()->GetNameStringByValue(static_cast<int64>(Stage));
+}
+void UGoMockBenchmark::BeginStage(EGoOnlineOperation Stage)
+{
+	RunningStage = Stage;
+	//~ Allocations are counted by the engine's memory trace: a -trace=memory capture shows each stage as a region in Insights.
+	TRACE_BEGIN_REGION(*GetStageRegionName(Stage));
+	StageStartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	StageStartTime = FPlatformTime::Seconds();
+}
+bool UGoMockBenchmark::EndStage(EGoOnlineOperation Stage, bool bWasSuccess)
+{
+	if (RunningStage != Stage) return false;
+
+	const double Milliseconds = (FPlatformTime::Seconds() - StageStartTime) * 1000.0;
+	FStageStats& Stats = Stages[static_cast<int32>(Stage)];
+	Stats.Latency.Add(Milliseconds);
+	Stats.UsedPhysicalGrowth += static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(StageStartUsedPhysical);
+	TRACE_END_REGION(*GetStageRegionName(Stage));
+	if (!bWasSuccess) ++Stats.Failures;
+	RunningStage = EGoOnlineOperation::Count;
+	return true;
+}
+bool UGoMockBenchmark::CheckStageTimeout(float DeltaTime)
+{
+	if (RunningStage == EGoOnlineOperation::Count || FPlatformTime::Seconds() - StageStartTime < StageTimeoutSeconds) return true;
+
+	UE_LOG(LogEOSGo, Warning, TEXT("EOSGo mock benchmark: %s did not complete within %.0f s"),
+		*StaticEnum<EGoOnlineOperation>()->GetNameStringByValue(static_cast<int64>(RunningStage)), StageTimeoutSeconds);
+	EndStage(RunningStage, false);
+	Finish();
+	return false;
+}
+
+
+void UGoMockBenchmark::StartIteration()
+{
+	if (IterationsLeft-- <= 0)
+	{
+		Finish();
+		return;
+	}
+	++IterationsRun;
+
+	//~ LOGIN - the mock logs in again even when already logged in.
+	BeginStage(EGoOnlineOperation::Login);
+	GoSubsystem->GoEOSLogin(TEXT("mock"), FString(), TEXT("developer"), FGoOnRequestComplete::CreateUObject(this, &ThisClass::OnLoginComplete));
+}
+void UGoMockBenchmark::OnLoginComplete(const FGoRequestResult& Result)
+{
+	if (!EndStage(EGoOnlineOperation::Login, Result.bWasSuccessful)) return;
+
+	//~ Every later stage needs a logged in user.
+	if (!Result.bWasSuccessful)
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo mock benchmark: login failed"));
+		Finish();
+		return;
+	}
+
+	//~ CREATE
+	BeginStage(EGoOnlineOperation::Create);
+	GoSubsystem->GoCreateSession(0, TEXT("DUO"), 0, false);
+}
+void UGoMockBenchmark::OnCreateSessionComplete(bool bWasSuccessful)
+{
+	if (!EndStage(EGoOnlineOperation::Create, bWasSuccessful)) return;
+
+	//~ FIND - always a backend query, never the cache.
+	BeginStage(EGoOnlineOperation::Find);
+	GoSubsystem->InvalidateSessionSearchCache();
+	GoSubsystem->GoFindSessions(0, FName("DUO"));
+}
+void UGoMockBenchmark::OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
+{
+	if (!EndStage(EGoOnlineOperation::Find, bWasSuccessful)) return;
+
+	StartJoin(SessionResults);
+}
+void UGoMockBenchmark::StartJoin(const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	//~ JOIN - the hosted session is destroyed first, as when a host joins another lobby.
+	BeginStage(EGoOnlineOperation::Join);
+	GoSubsystem->GoJoinBestSession(SessionResults, FName("DUO"));
+}
+void UGoMockBenchmark::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (!EndStage(EGoOnlineOperation::Join, Result == EOnJoinSessionCompleteResult::Success)) return;
+
+	//~ START
+	BeginStage(EGoOnlineOperation::Start);
+	GoSubsystem->GoStartSession();
+}
+void UGoMockBenchmark::OnStartSessionComplete(bool bWasSuccessful)
+{
+	if (!EndStage(EGoOnlineOperation::Start, bWasSuccessful)) return;
+
+	StartRegisterBurst();
+}
+
+
+void UGoMockBenchmark::StartRegisterBurst()
+{
+	AGoGameModeBase* GameMode = GoGameModeBase.Get();
+	if (!GameMode || BurstPlayers.IsEmpty())
+	{
+		StartDestroy();
+		return;
+	}
+
+	//~ REGISTER PLAYERS - timed until every player's result arrived, however the game mode batched them.
+	BeginStage(EGoOnlineOperation::RegisterPlayers);
+	BurstResultsLeft = BurstPlayers.Num();
+	bBurstSucceeded = true;
+	for (const FUniqueNetIdRef& Player : BurstPlayers) GameMode->GoRegisterPlayerId(Player);
+}
+void UGoMockBenchmark::OnRegisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess)
+{
+	if (RunningStage != EGoOnlineOperation::RegisterPlayers) return;
+
+	bBurstSucceeded &= bWasSuccess;
+	if (--BurstResultsLeft > 0) return;
+
+	EndStage(EGoOnlineOperation::RegisterPlayers, bBurstSucceeded);
+	StartUnregisterBurst();
+}
+void UGoMockBenchmark::StartUnregisterBurst()
+{
+	AGoGameModeBase* GameMode = GoGameModeBase.Get();
+	if (!GameMode)
+	{
+		StartDestroy();
+		return;
+	}
+
+	//~ UNREGISTER PLAYERS
+	BeginStage(EGoOnlineOperation::UnregisterPlayers);
+	BurstResultsLeft = BurstPlayers.Num();
+	bBurstSucceeded = true;
+	for (const FUniqueNetIdRef& Player : BurstPlayers) GameMode->GoUnregisterPlayerId(Player);
+}
+void UGoMockBenchmark::OnUnregisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess)
+{
+	if (RunningStage != EGoOnlineOperation::UnregisterPlayers) return;
+
+	bBurstSucceeded &= bWasSuccess;
+	if (--BurstResultsLeft > 0) return;
+
+	EndStage(EGoOnlineOperation::UnregisterPlayers, bBurstSucceeded);
+	StartDestroy();
+}
+
+
+void UGoMockBenchmark::StartDestroy()
+{
+	//~ DESTROY
+	BeginStage(EGoOnlineOperation::Destroy);
+	GoSubsystem->GoDestroySession();
+}
+void UGoMockBenchmark::OnDestroySessionComplete(bool bWasSuccessful)
+{
+	if (!EndStage(EGoOnlineOperation::Destroy, bWasSuccessful)) return;
+
+	StartIteration();
+}
+
+
+void UGoMockBenchmark::Finish()
+{
+	UE_LOG(LogEOSGo, Display, TEXT("EOSGo mock benchmark: %d iteration(s), burst of %d player(s), stage latency (ms) and process memory growth:"), IterationsRun, BurstPlayers.Num());
+	for (int32 Index = 0; Index < static_cast<int32>(EGoOnlineOperation::Count); ++Index)
+	{
+		const FStageStats& Stats = Stages[Index];
+		if (Stats.Latency.Count == 0) continue;
+
+		UE_LOG(LogEOSGo, Display, TEXT("  %-18s n=%llu failed=%u p50=%.1f p95=%.1f p99=%.1f max=%.1f mean=%.1f mem=%.1f KiB/op"),
+			*StaticEnum<EGoOnlineOperation>()->GetNameStringByValue(Index), Stats.Latency.Count, Stats.Failures,
+			Stats.Latency.GetPercentile(0.50f), Stats.Latency.GetPercentile(0.95f), Stats.Latency.GetPercentile(0.99f),
+			Stats.Latency.MaxMs, Stats.Latency.TotalMs / Stats.Latency.Count,
+			static_cast<double>(Stats.UsedPhysicalGrowth) / 1024.0 / Stats.Latency.Count);
+	}
+	//~ Backend request-to-completion times, without the queueing the stages above include.
+	if (GLog) FGoOperationMetrics::Get().Dump(*GLog);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(StageTimeoutHandle);
+	if (GoSubsystem)
+	{
+		GoSubsystem->GoOnCreateSessionComplete.RemoveDynamic(this, &ThisClass::OnCreateSessionComplete);
+		GoSubsystem->GoOnFindSessionsComplete.Remove(FindSessionsHandle);
+		GoSubsystem->GoOnJoinSessionComplete.Remove(JoinSessionHandle);
+		GoSubsystem->GoOnStartSessionComplete.RemoveDynamic(this, &ThisClass::OnStartSessionComplete);
+		GoSubsystem->GoOnDestroySessionComplete.RemoveDynamic(this, &ThisClass::OnDestroySessionComplete);
+	}
+	if (AGoGameModeBase* GameMode = GoGameModeBase.Get())
+	{
+		GameMode->GoOnRegisterPlayerResult.Remove(RegisterPlayerResultHandle);
+		GameMode->GoOnUnregisterPlayerResult.Remove(UnregisterPlayerResultHandle);
+	}
+
+	ActiveBenchmark = nullptr;
+	RemoveFromRoot();
+	if (bExitWhenDone) FPlatformMisc::RequestExit(false);
+}
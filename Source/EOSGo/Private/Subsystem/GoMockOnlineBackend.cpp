@@ -0,0 +1,660 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoMockOnlineBackend.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "EOSGo.h"
+#include "Subsystem/GoOnlineTrace.h"
+#include "Subsystem/GoSessionAttributes.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "OnlineError.h"
+#include "OnlineSubsystemTypes.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarMockEnabled(
+		TEXT("EOSGo.Mock.Enabled"), false,
+		TEXT("Use the in-process mock backend instead of the online subsystem. Read when EOSGo acquires its online interfaces; -EOSGoMock does the same."));
+	TAutoConsoleVariable<float> CVarMockLatencyMs(
+		TEXT("EOSGo.Mock.LatencyMs"), 50.f,
+		TEXT("Time (ms) the mock backend takes to complete a request."));
+	TAutoConsoleVariable<float> CVarMockLatencyJitterMs(
+		TEXT("EOSGo.Mock.LatencyJitterMs"), 0.f,
+		TEXT("Random latency (ms) added to or removed from EOSGo.Mock.LatencyMs."));
+	TAutoConsoleVariable<float> CVarMockFailureRate(
+		TEXT("EOSGo.Mock.FailureRate"), 0.f,
+		TEXT("Share of mock backend requests, in [0, 1], that complete with a failure."));
+	TAutoConsoleVariable<int32> CVarMockRemoteSessions(
+		TEXT("EOSGo.Mock.RemoteSessions"), 4,
+		TEXT("Synthetic remote sessions added to each mock search. They match the search and can be joined."));
+	TAutoConsoleVariable<int32> CVarMockSearchBatches(
+		TEXT("EOSGo.Mock.SearchBatches"), 1,
+		TEXT("Batches a mock search reveals its results in, spread over EOSGo.Mock.LatencyMs as with backends that stream results. 1 fills them on completion."));
+
+	const FName MockIdType(TEXT("MOCK"));
+	const TCHAR* MockConnectString = TEXT("127.0.0.1:7777");
+	const TCHAR* MockServerName = TEXT("MockDedicatedServer");
+	constexpr int32 MockRemoteSessionConnections = 4;
+
+	bool MatchesSearch(const FOnlineSessionSettings& Settings, const FOnlineSessionSearch& Search)
+	{
+		for (const TPair<FName, FOnlineSessionSearchParam>& Param : Search.QuerySettings.SearchParams)
+		{
+			//~ The mock has no special search keys: only Equals on attributes the session defines is checked.
+			const FOnlineSessionSetting* Setting = Settings.Settings.Find(Param.Key);
+			if (!Setting || Param.Value.ComparisonOp != EOnlineComparisonOp::Equals) continue;
+
+			//~ Compare as strings so int32 settings match int64 search parameters.
+			if (Setting->Data.ToString() != Param.Value.Data.ToString()) return false;
+		}
+		return true;
+	}
+	//~ Beacon connect strings swap the game port for the session's advertised beacon port, as the EOS session interface does.
+	bool ResolveConnectString(const FGoMockSessionInfo& SessionInfo, const FOnlineSessionSettings& Settings, FName PortType, FString& ConnectInfo)
+	{
+		ConnectInfo = SessionInfo.ConnectString;
+		if (PortType != NAME_BeaconPort) return true;
+
+		int32 BeaconPort = 0;
+		FString Host;
+		if (!EOSGo::SessionAttributes::BeaconPort.Get(Settings, BeaconPort) || BeaconPort <= 0) return false;
+		if (!ConnectInfo.Split(TEXT(":"), &Host, nullptr, ESearchCase::IgnoreCase, ESearchDir::FromEnd)) Host = ConnectInfo;
+		ConnectInfo = FString::Printf(TEXT("%s:%d"), *Host, BeaconPort);
+		return true;
+	}
+}
+
+
+bool FGoMockOnlineBackend::IsEnabled()
+{
+	static const bool bEnabledOnCommandLine = FParse::Param(FCommandLine::Get(), TEXT("EOSGoMock"));
+	return bEnabledOnCommandLine || CVarMockEnabled.GetValueOnGameThread() || FGoOnlineTraceReplay::Get().IsActive();
+}
+FGoMockOnlineBackend& FGoMockOnlineBackend::Get()
+{
+	static FGoMockOnlineBackend Backend;
+	return Backend;
+}
+FGoMockOnlineBackend::FGoMockOnlineBackend() :
+//~ Fixed seed so runs with the same settings are reproducible.
+Random(0x60C0FFEE),
+Session(MakeShared<FGoMockOnlineSession, ESPMode::ThreadSafe>()),
+Identity(MakeShared<FGoMockOnlineIdentity, ESPMode::ThreadSafe>())
+{
+}
+
+IOnlineSessionPtr FGoMockOnlineBackend::GetSessionInterface() const
+{
+	return Session;
+}
+IOnlineIdentityPtr FGoMockOnlineBackend::GetIdentityInterface() const
+{
+	return Identity;
+}
+
+void FGoMockOnlineBackend::Schedule(EGoOnlineOperation Operation, TFunction<void(bool bWasSuccess)>&& Completion)
+{
+	FPendingCompletion Entry;
+	Entry.Completion = MoveTemp(Completion);
+
+	FGoOnlineTraceReplay::FCompletion Replayed;
+	if (FGoOnlineTraceReplay::Get().Take(Operation, Replayed))
+	{
+		Entry.DueTime = FPlatformTime::Seconds() + Replayed.LatencySeconds;
+		Entry.bWasSuccess = Replayed.bWasSuccess;
+		Entry.ReplayedDetail = Replayed.Detail;
+	}
+	else
+	{
+		const float JitterMs = CVarMockLatencyJitterMs.GetValueOnGameThread();
+		const float LatencyMs = FMath::Max(0.f, CVarMockLatencyMs.GetValueOnGameThread() + (JitterMs > 0.f ? Random.FRandRange(-JitterMs, JitterMs) : 0.f));
+		Entry.DueTime = FPlatformTime::Seconds() + LatencyMs / 1000.0;
+		Entry.bWasSuccess = Random.FRand() >= CVarMockFailureRate.GetValueOnGameThread();
+	}
+
+	Insert(MoveTemp(Entry));
+}
+void FGoMockOnlineBackend::ScheduleAfter(double DelaySeconds, TFunction<void()>&& Callback)
+{
+	FPendingCompletion Entry;
+	Entry.DueTime = FPlatformTime::Seconds() + FMath::Max(0.0, DelaySeconds);
+	Entry.Completion = [Callback = MoveTemp(Callback)](bool) { Callback(); };
+	Insert(MoveTemp(Entry));
+}
+void FGoMockOnlineBackend::Insert(FPendingCompletion&& Entry)
+{
+	//~ Insert after every entry due at the same time or earlier, keeping request order for equal latencies.
+	const int32 Index = Algo::UpperBoundBy(Pending, Entry.DueTime, &FPendingCompletion::DueTime);
+	Pending.Insert(MoveTemp(Entry), Index);
+
+	//~ Completions never run inside the request, as with a real backend.
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGoMockOnlineBackend::Tick));
+	}
+}
+bool FGoMockOnlineBackend::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	int32 NumDue = 0;
+	while (NumDue < Pending.Num() && Pending[NumDue].DueTime <= Now) ++NumDue;
+
+	//~ Take the due entries out first: completions may schedule new requests.
+	TArray<FPendingCompletion> Due;
+	Due.Reserve(NumDue);
+	for (int32 Index = 0; Index < NumDue; ++Index) Due.Add(MoveTemp(Pending[Index]));
+	Pending.RemoveAt(0, NumDue, EAllowShrinking::No);
+
+	for (FPendingCompletion& Entry : Due)
+	{
+		RunningDetail = Entry.ReplayedDetail;
+		Entry.Completion(Entry.bWasSuccess);
+	}
+	RunningDetail.Reset();
+
+	if (Pending.IsEmpty())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+void FGoMockOnlineBackend::Reset()
+{
+	Pending.Reset();
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+
+FUniqueNetIdPtr FGoMockOnlineSession::CreateSessionIdFromString(const FString& SessionIdStr)
+{
+	return SessionIdStr.IsEmpty() ? nullptr : FUniqueNetIdString::Create(SessionIdStr, MockIdType);
+}
+FUniqueNetIdRef FGoMockOnlineSession::MakeSessionId()
+{
+	return FUniqueNetIdString::Create(FString::Printf(TEXT("MockSession_%d"), NextSessionId++), MockIdType);
+}
+FNamedOnlineSession* FGoMockOnlineSession::GetNamedSession(FName SessionName)
+{
+	return Sessions.FindByPredicate([SessionName](const FNamedOnlineSession& Session) { return Session.SessionName == SessionName; });
+}
+const FNamedOnlineSession* FGoMockOnlineSession::FindNamedSession(FName SessionName) const
+{
+	return Sessions.FindByPredicate([SessionName](const FNamedOnlineSession& Session) { return Session.SessionName == SessionName; });
+}
+void FGoMockOnlineSession::RemoveNamedSession(FName SessionName)
+{
+	Sessions.RemoveAll([SessionName](const FNamedOnlineSession& Session) { return Session.SessionName == SessionName; });
+}
+bool FGoMockOnlineSession::HasPresenceSession()
+{
+	return Sessions.ContainsByPredicate([](const FNamedOnlineSession& Session) { return Session.SessionSettings.bUsesPresence; });
+}
+EOnlineSessionState::Type FGoMockOnlineSession::GetSessionState(FName SessionName) const
+{
+	const FNamedOnlineSession* Session = FindNamedSession(SessionName);
+	return Session ? Session->SessionState : EOnlineSessionState::NoSession;
+}
+FNamedOnlineSession* FGoMockOnlineSession::AddNamedSession(FName SessionName, const FOnlineSessionSettings& SessionSettings)
+{
+	return &Sessions.Emplace_GetRef(SessionName, SessionSettings);
+}
+FNamedOnlineSession* FGoMockOnlineSession::AddNamedSession(FName SessionName, const FOnlineSession& Session)
+{
+	return &Sessions.Emplace_GetRef(SessionName, Session);
+}
+FOnlineSessionSettings* FGoMockOnlineSession::GetSessionSettings(FName SessionName)
+{
+	FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	return Session ? &Session->SessionSettings : nullptr;
+}
+
+
+bool FGoMockOnlineSession::CreateSession(int32 HostingPlayerNum, FName SessionName, const FOnlineSessionSettings& NewSessionSettings)
+{
+	FUniqueNetIdPtr HostingPlayerId = FGoMockOnlineBackend::Get().GetIdentityInterface()->GetUniquePlayerId(HostingPlayerNum);
+	//~ Dedicated servers host without logging in, under the server's own identity.
+	if (!HostingPlayerId.IsValid() && NewSessionSettings.bIsDedicated) HostingPlayerId = FUniqueNetIdString::Create(MockServerName, MockIdType);
+	return HostingPlayerId.IsValid() && CreateSession(*HostingPlayerId, SessionName, NewSessionSettings);
+}
+bool FGoMockOnlineSession::CreateSession(const FUniqueNetId& HostingPlayerId, FName SessionName, const FOnlineSessionSettings& NewSessionSettings)
+{
+	if (GetNamedSession(SessionName))
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("[Mock] CreateSession: session %s already exists"), *SessionName.ToString());
+		return false;
+	}
+
+	FNamedOnlineSession* Session = AddNamedSession(SessionName, NewSessionSettings);
+	Session->SessionState = EOnlineSessionState::Creating;
+	Session->bHosting = true;
+	Session->OwningUserId = HostingPlayerId.AsShared();
+	Session->LocalOwnerId = HostingPlayerId.AsShared();
+	Session->OwningUserName = FGoMockOnlineBackend::Get().GetIdentityInterface()->GetPlayerNickname(HostingPlayerId);
+	Session->NumOpenPublicConnections = NewSessionSettings.NumPublicConnections;
+	Session->NumOpenPrivateConnections = NewSessionSettings.NumPrivateConnections;
+	Session->SessionInfo = MakeShared<FGoMockSessionInfo>(MakeSessionId(), MockConnectString);
+
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Create, [this, SessionName](bool bWasSuccess)
+	{
+		FNamedOnlineSession* CreatedSession = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && CreatedSession;
+		if (bWasSuccess) CreatedSession->SessionState = EOnlineSessionState::Pending;
+		else RemoveNamedSession(SessionName);
+		TriggerOnCreateSessionCompleteDelegates(SessionName, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::StartSession(FName SessionName)
+{
+	FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	if (!Session || (Session->SessionState != EOnlineSessionState::Pending && Session->SessionState != EOnlineSessionState::Ended)) return false;
+
+	Session->SessionState = EOnlineSessionState::Starting;
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Start, [this, SessionName](bool bWasSuccess)
+	{
+		FNamedOnlineSession* StartedSession = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && StartedSession;
+		if (StartedSession) StartedSession->SessionState = bWasSuccess ? EOnlineSessionState::InProgress : EOnlineSessionState::Pending;
+		TriggerOnStartSessionCompleteDelegates(SessionName, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::UpdateSession(FName SessionName, FOnlineSessionSettings& UpdatedSessionSettings, bool bShouldRefreshOnlineData)
+{
+	if (!GetNamedSession(SessionName)) return false;
+
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Update, [this, SessionName, Settings = UpdatedSessionSettings](bool bWasSuccess)
+	{
+		FNamedOnlineSession* UpdatedSession = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && UpdatedSession;
+		if (bWasSuccess) UpdatedSession->SessionSettings = Settings;
+		TriggerOnUpdateSessionCompleteDelegates(SessionName, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::EndSession(FName SessionName)
+{
+	FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	if (!Session || Session->SessionState != EOnlineSessionState::InProgress) return false;
+
+	Session->SessionState = EOnlineSessionState::Ending;
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Count, [this, SessionName](bool bWasSuccess)
+	{
+		FNamedOnlineSession* EndedSession = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && EndedSession;
+		if (EndedSession) EndedSession->SessionState = bWasSuccess ? EOnlineSessionState::Ended : EOnlineSessionState::InProgress;
+		TriggerOnEndSessionCompleteDelegates(SessionName, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::DestroySession(FName SessionName, const FOnDestroySessionCompleteDelegate& CompletionDelegate)
+{
+	FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	if (!Session) return false;
+
+	const EOnlineSessionState::Type StateBeforeDestroy = Session->SessionState;
+	Session->SessionState = EOnlineSessionState::Destroying;
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Destroy, [this, SessionName, StateBeforeDestroy, CompletionDelegate](bool bWasSuccess)
+	{
+		if (bWasSuccess) RemoveNamedSession(SessionName);
+		else if (FNamedOnlineSession* KeptSession = GetNamedSession(SessionName)) KeptSession->SessionState = StateBeforeDestroy;
+		CompletionDelegate.ExecuteIfBound(SessionName, bWasSuccess);
+		TriggerOnDestroySessionCompleteDelegates(SessionName, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::IsPlayerInSession(FName SessionName, const FUniqueNetId& UniqueId)
+{
+	const FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	return Session && Session->RegisteredPlayers.ContainsByPredicate([&UniqueId](const FUniqueNetIdRef& Player) { return *Player == UniqueId; });
+}
+
+
+bool FGoMockOnlineSession::FindSessions(int32 SearchingPlayerNum, const TSharedRef<FOnlineSessionSearch>& SearchSettings)
+{
+	const FUniqueNetIdPtr SearchingPlayerId = FGoMockOnlineBackend::Get().GetIdentityInterface()->GetUniquePlayerId(SearchingPlayerNum);
+	return SearchingPlayerId.IsValid() && FindSessions(*SearchingPlayerId, SearchSettings);
+}
+bool FGoMockOnlineSession::FindSessions(const FUniqueNetId& SearchingPlayerId, const TSharedRef<FOnlineSessionSearch>& SearchSettings)
+{
+	if (CurrentSearch.IsValid()) return false;
+
+	CurrentSearch = SearchSettings;
+	SearchSettings->SearchState = EOnlineAsyncTaskState::InProgress;
+	SearchSettings->SearchResults.Reset();
+
+	//~ Replayed searches complete with their recorded result count only.
+	const int32 NumBatches = FGoOnlineTraceReplay::Get().IsActive() ? 1 : FMath::Max(1, CVarMockSearchBatches.GetValueOnGameThread());
+	if (NumBatches > 1) StageSearchResults(SearchSettings, NumBatches);
+
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Find, [this, SearchSettings, NumBatches](bool bWasSuccess)
+	{
+		//~ A cancelled search already reported its completion.
+		if (CurrentSearch != SearchSettings) return;
+		CurrentSearch.Reset();
+
+		if (!bWasSuccess)
+		{
+			SearchSettings->SearchResults.Reset();
+		}
+		else if (NumBatches > 1)
+		{
+			RevealStagedSearchResults(*SearchSettings, StagedSearchResults.Num());
+		}
+		else
+		{
+			FillSearchResults(*SearchSettings, FGoMockOnlineBackend::Get().GetReplayedDetail());
+		}
+		StagedSearchResults.Reset();
+		SearchSettings->SearchState = bWasSuccess ? EOnlineAsyncTaskState::Done : EOnlineAsyncTaskState::Failed;
+		TriggerOnFindSessionsCompleteDelegates(bWasSuccess);
+	});
+	return true;
+}
+void FGoMockOnlineSession::FillSearchResults(FOnlineSessionSearch& Search, const TOptional<int32>& NumResults)
+{
+	for (const FNamedOnlineSession& Session : Sessions)
+	{
+		if (Search.SearchResults.Num() >= Search.MaxSearchResults) return;
+		if (!Session.bHosting || !Session.SessionSettings.bShouldAdvertise || !MatchesSearch(Session.SessionSettings, Search)) continue;
+
+		FOnlineSessionSearchResult& Result = Search.SearchResults.AddDefaulted_GetRef();
+		Result.Session = Session;
+		Result.PingInMs = 0;
+	}
+
+	//~ Remote sessions are shaped after the search so they always match it.
+	FRandomStream& Random = FGoMockOnlineBackend::Get().GetRandom();
+	const int32 NumRemoteSessions = FMath::Max(0, NumResults.IsSet() ? NumResults.GetValue() - Search.SearchResults.Num() : CVarMockRemoteSessions.GetValueOnGameThread());
+	for (int32 Index = 0; Index < NumRemoteSessions && Search.SearchResults.Num() < Search.MaxSearchResults; ++Index)
+	{
+		FOnlineSessionSettings Settings;
+		Settings.NumPublicConnections = MockRemoteSessionConnections;
+		Settings.bShouldAdvertise = true;
+		for (const TPair<FName, FOnlineSessionSearchParam>& Param : Search.QuerySettings.SearchParams)
+		{
+			Settings.Set(Param.Key, Param.Value.Data, EOnlineDataAdvertisementType::ViaOnlineService);
+		}
+
+		FOnlineSessionSearchResult& Result = Search.SearchResults.AddDefaulted_GetRef();
+		Result.Session.SessionSettings = MoveTemp(Settings);
+		Result.Session.OwningUserName = FString::Printf(TEXT("MockHost_%d"), Index);
+		Result.Session.OwningUserId = FUniqueNetIdString::Create(Result.Session.OwningUserName, MockIdType);
+		//~ Some are full, so callers exercise their filtering.
+		Result.Session.NumOpenPublicConnections = Random.RandRange(0, MockRemoteSessionConnections - 1);
+		Result.Session.SessionInfo = MakeShared<FGoMockSessionInfo>(MakeSessionId(), MockConnectString);
+		Result.PingInMs = Random.RandRange(10, 150);
+	}
+}
+void FGoMockOnlineSession::StageSearchResults(const TSharedRef<FOnlineSessionSearch>& SearchSettings, int32 NumBatches)
+{
+	//~ The results are settled when the search starts so every batch belongs to the same result set.
+	FOnlineSessionSearch Staging;
+	Staging.MaxSearchResults = SearchSettings->MaxSearchResults;
+	Staging.QuerySettings = SearchSettings->QuerySettings;
+	FillSearchResults(Staging, TOptional<int32>());
+	StagedSearchResults = MoveTemp(Staging.SearchResults);
+
+	const double LatencySeconds = FMath::Max(0.f, CVarMockLatencyMs.GetValueOnGameThread()) / 1000.0;
+	for (int32 Batch = 1; Batch < NumBatches; ++Batch)
+	{
+		const int32 NumRevealed = StagedSearchResults.Num() * Batch / NumBatches;
+		FGoMockOnlineBackend::Get().ScheduleAfter(LatencySeconds * Batch / NumBatches, [this, SearchSettings, NumRevealed]
+		{
+			if (CurrentSearch == SearchSettings) RevealStagedSearchResults(*SearchSettings, NumRevealed);
+		});
+	}
+}
+void FGoMockOnlineSession::RevealStagedSearchResults(FOnlineSessionSearch& Search, int32 NumRevealed)
+{
+	NumRevealed = FMath::Min(NumRevealed, StagedSearchResults.Num());
+	for (int32 Index = Search.SearchResults.Num(); Index < NumRevealed; ++Index)
+	{
+		Search.SearchResults.Add(StagedSearchResults[Index]);
+	}
+}
+bool FGoMockOnlineSession::FindSessionById(const FUniqueNetId& SearchingUserId, const FUniqueNetId& SessionId, const FUniqueNetId& FriendId, const FOnSingleSessionResultCompleteDelegate& CompletionDelegate)
+{
+	//~ Only sessions hosted in this process have ids that can be looked up.
+	const FString SessionIdString = SessionId.ToString();
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Find, [this, SessionIdString, CompletionDelegate](bool bWasSuccess)
+	{
+		FOnlineSessionSearchResult Result;
+		const FNamedOnlineSession* Session = Sessions.FindByPredicate([&SessionIdString](const FNamedOnlineSession& HostedSession)
+		{
+			return HostedSession.bHosting && HostedSession.SessionInfo.IsValid() && HostedSession.SessionInfo->GetSessionId().ToString() == SessionIdString;
+		});
+		bWasSuccess = bWasSuccess && Session;
+		if (bWasSuccess) Result.Session = *Session;
+		CompletionDelegate.ExecuteIfBound(0, bWasSuccess, Result);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::CancelFindSessions()
+{
+	if (!CurrentSearch.IsValid()) return false;
+
+	const TSharedPtr<FOnlineSessionSearch> CancelledSearch = MoveTemp(CurrentSearch);
+	CurrentSearch.Reset();
+	StagedSearchResults.Reset();
+	CancelledSearch->SearchState = EOnlineAsyncTaskState::Failed;
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Count, [this](bool)
+	{
+		TriggerOnCancelFindSessionsCompleteDelegates(true);
+	});
+	return true;
+}
+
+
+bool FGoMockOnlineSession::JoinSession(int32 LocalUserNum, FName SessionName, const FOnlineSessionSearchResult& DesiredSession)
+{
+	const FUniqueNetIdPtr LocalUserId = FGoMockOnlineBackend::Get().GetIdentityInterface()->GetUniquePlayerId(LocalUserNum);
+	return LocalUserId.IsValid() && JoinSession(*LocalUserId, SessionName, DesiredSession);
+}
+bool FGoMockOnlineSession::JoinSession(const FUniqueNetId& LocalUserId, FName SessionName, const FOnlineSessionSearchResult& DesiredSession)
+{
+	if (GetNamedSession(SessionName))
+	{
+		FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Join, [this, SessionName](bool)
+		{
+			TriggerOnJoinSessionCompleteDelegates(SessionName, EOnJoinSessionCompleteResult::AlreadyInSession);
+		});
+		return true;
+	}
+	if (!DesiredSession.IsValid()) return false;
+
+	FNamedOnlineSession* Session = AddNamedSession(SessionName, DesiredSession.Session);
+	Session->SessionState = EOnlineSessionState::Pending;
+	Session->bHosting = false;
+	Session->LocalOwnerId = LocalUserId.AsShared();
+
+	const bool bIsFull = DesiredSession.Session.NumOpenPublicConnections <= 0;
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Join, [this, SessionName, bIsFull](bool bWasSuccess)
+	{
+		EOnJoinSessionCompleteResult::Type Result = bIsFull ? EOnJoinSessionCompleteResult::SessionIsFull
+			: bWasSuccess ? EOnJoinSessionCompleteResult::Success : EOnJoinSessionCompleteResult::UnknownError;
+		//~ A replayed join fails the way the recorded one did.
+		if (const TOptional<int32>& Detail = FGoMockOnlineBackend::Get().GetReplayedDetail(); Detail.IsSet())
+		{
+			const EOnJoinSessionCompleteResult::Type Recorded = static_cast<EOnJoinSessionCompleteResult::Type>(Detail.GetValue());
+			Result = bWasSuccess ? EOnJoinSessionCompleteResult::Success
+				: Recorded != EOnJoinSessionCompleteResult::Success ? Recorded : EOnJoinSessionCompleteResult::UnknownError;
+		}
+		if (Result != EOnJoinSessionCompleteResult::Success) RemoveNamedSession(SessionName);
+		TriggerOnJoinSessionCompleteDelegates(SessionName, Result);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::GetResolvedConnectString(FName SessionName, FString& ConnectInfo, FName PortType)
+{
+	const FNamedOnlineSession* Session = GetNamedSession(SessionName);
+	if (!Session || !Session->SessionInfo.IsValid()) return false;
+
+	return ResolveConnectString(*StaticCastSharedPtr<FGoMockSessionInfo>(Session->SessionInfo), Session->SessionSettings, PortType, ConnectInfo);
+}
+bool FGoMockOnlineSession::GetResolvedConnectString(const FOnlineSessionSearchResult& SearchResult, FName PortType, FString& ConnectInfo)
+{
+	if (!SearchResult.Session.SessionInfo.IsValid()) return false;
+
+	return ResolveConnectString(*StaticCastSharedPtr<const FGoMockSessionInfo>(SearchResult.Session.SessionInfo), SearchResult.Session.SessionSettings, PortType, ConnectInfo);
+}
+
+
+bool FGoMockOnlineSession::RegisterPlayer(FName SessionName, const FUniqueNetId& PlayerId, bool bWasInvited)
+{
+	return RegisterPlayers(SessionName, {PlayerId.AsShared()}, bWasInvited);
+}
+bool FGoMockOnlineSession::RegisterPlayers(FName SessionName, const TArray<FUniqueNetIdRef>& Players, bool bWasInvited)
+{
+	if (!GetNamedSession(SessionName)) return false;
+
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::RegisterPlayers, [this, SessionName, Players](bool bWasSuccess)
+	{
+		FNamedOnlineSession* Session = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && Session;
+		if (bWasSuccess)
+		{
+			for (const FUniqueNetIdRef& Player : Players)
+			{
+				if (IsPlayerInSession(SessionName, *Player)) continue;
+				Session->RegisteredPlayers.Add(Player);
+				if (Session->NumOpenPublicConnections > 0) --Session->NumOpenPublicConnections;
+			}
+		}
+		TriggerOnRegisterPlayersCompleteDelegates(SessionName, Players, bWasSuccess);
+	});
+	return true;
+}
+bool FGoMockOnlineSession::UnregisterPlayer(FName SessionName, const FUniqueNetId& PlayerId)
+{
+	return UnregisterPlayers(SessionName, {PlayerId.AsShared()});
+}
+bool FGoMockOnlineSession::UnregisterPlayers(FName SessionName, const TArray<FUniqueNetIdRef>& Players)
+{
+	if (!GetNamedSession(SessionName)) return false;
+
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::UnregisterPlayers, [this, SessionName, Players](bool bWasSuccess)
+	{
+		FNamedOnlineSession* Session = GetNamedSession(SessionName);
+		bWasSuccess = bWasSuccess && Session;
+		if (bWasSuccess)
+		{
+			for (const FUniqueNetIdRef& Player : Players)
+			{
+				const int32 Removed = Session->RegisteredPlayers.RemoveAll([&Player](const FUniqueNetIdRef& Registered) { return *Registered == *Player; });
+				if (Removed > 0) Session->NumOpenPublicConnections = FMath::Min(Session->NumOpenPublicConnections + 1, Session->SessionSettings.NumPublicConnections);
+			}
+		}
+		TriggerOnUnregisterPlayersCompleteDelegates(SessionName, Players, bWasSuccess);
+	});
+	return true;
+}
+void FGoMockOnlineSession::RegisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnRegisterLocalPlayerCompleteDelegate& Delegate)
+{
+	Delegate.ExecuteIfBound(PlayerId, EOnJoinSessionCompleteResult::Success);
+}
+void FGoMockOnlineSession::UnregisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnUnregisterLocalPlayerCompleteDelegate& Delegate)
+{
+	Delegate.ExecuteIfBound(PlayerId, true);
+}
+void FGoMockOnlineSession::DumpSessionState()
+{
+	for (const FNamedOnlineSession& Session : Sessions)
+	{
+		UE_LOG(LogEOSGoSession, Display, TEXT("[Mock] %s: %s, %s, %d/%d open, %d registered"),
+			*Session.SessionName.ToString(), EOnlineSessionState::ToString(Session.SessionState), Session.bHosting ? TEXT("host") : TEXT("client"),
+			Session.NumOpenPublicConnections, Session.SessionSettings.NumPublicConnections, Session.RegisteredPlayers.Num());
+	}
+}
+
+
+bool FGoMockOnlineIdentity::Login(int32 LocalUserNum, const FOnlineAccountCredentials& AccountCredentials)
+{
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Login, [this, LocalUserNum](bool bWasSuccess)
+	{
+		if (!bWasSuccess)
+		{
+			TriggerOnLoginCompleteDelegates(LocalUserNum, false, *FUniqueNetIdString::EmptyId(), TEXT("Mock login failure"));
+			return;
+		}
+
+		const FUniqueNetIdRef UserId = FUniqueNetIdString::Create(FString::Printf(TEXT("MockUser_%d"), LocalUserNum), MockIdType);
+		LoggedInUsers.Add(LocalUserNum, UserId);
+		TriggerOnLoginCompleteDelegates(LocalUserNum, true, *UserId, FString());
+	});
+	return true;
+}
+bool FGoMockOnlineIdentity::Logout(int32 LocalUserNum)
+{
+	FGoMockOnlineBackend::Get().Schedule(EGoOnlineOperation::Count, [this, LocalUserNum](bool)
+	{
+		LoggedInUsers.Remove(LocalUserNum);
+		TriggerOnLogoutCompleteDelegates(LocalUserNum, true);
+	});
+	return true;
+}
+bool FGoMockOnlineIdentity::AutoLogin(int32 LocalUserNum)
+{
+	return Login(LocalUserNum, FOnlineAccountCredentials());
+}
+FUniqueNetIdPtr FGoMockOnlineIdentity::GetUniquePlayerId(int32 LocalUserNum) const
+{
+	const FUniqueNetIdRef* UserId = LoggedInUsers.Find(LocalUserNum);
+	return UserId ? FUniqueNetIdPtr(*UserId) : nullptr;
+}
+FUniqueNetIdPtr FGoMockOnlineIdentity::CreateUniquePlayerId(uint8* Bytes, int32 Size)
+{
+	if (!Bytes || Size <= 0) return nullptr;
+	return CreateUniquePlayerId(BytesToString(Bytes, Size));
+}
+FUniqueNetIdPtr FGoMockOnlineIdentity::CreateUniquePlayerId(const FString& Str)
+{
+	return FUniqueNetIdString::Create(Str, MockIdType);
+}
+ELoginStatus::Type FGoMockOnlineIdentity::GetLoginStatus(int32 LocalUserNum) const
+{
+	return LoggedInUsers.Contains(LocalUserNum) ? ELoginStatus::LoggedIn : ELoginStatus::NotLoggedIn;
+}
+ELoginStatus::Type FGoMockOnlineIdentity::GetLoginStatus(const FUniqueNetId& UserId) const
+{
+	for (const TPair<int32, FUniqueNetIdRef>& User : LoggedInUsers)
+	{
+		if (*User.Value == UserId) return ELoginStatus::LoggedIn;
+	}
+	return ELoginStatus::NotLoggedIn;
+}
+FString FGoMockOnlineIdentity::GetPlayerNickname(int32 LocalUserNum) const
+{
+	const FUniqueNetIdRef* UserId = LoggedInUsers.Find(LocalUserNum);
+	return UserId ? (*UserId)->ToString() : FString();
+}
+FString FGoMockOnlineIdentity::GetPlayerNickname(const FUniqueNetId& UserId) const
+{
+	return UserId.ToString();
+}
+void FGoMockOnlineIdentity::RevokeAuthToken(const FUniqueNetId& LocalUserId, const FOnRevokeAuthTokenCompleteDelegate& Delegate)
+{
+	Delegate.ExecuteIfBound(LocalUserId, FOnlineError(EOnlineErrorResult::NotImplemented));
+}
+void FGoMockOnlineIdentity::GetUserPrivilege(const FUniqueNetId& LocalUserId, EUserPrivileges::Type Privilege, const FOnGetUserPrivilegeCompleteDelegate& Delegate, EShowPrivilegeResolveUI ShowResolveUI)
+{
+	Delegate.ExecuteIfBound(LocalUserId, Privilege, static_cast<uint32>(EPrivilegeResults::NoFailures));
+}
+FPlatformUserId FGoMockOnlineIdentity::GetPlatformUserIdFromUniqueNetId(const FUniqueNetId& UniqueNetId) const
+{
+	for (const TPair<int32, FUniqueNetIdRef>& User : LoggedInUsers)
+	{
+		if (*User.Value == UniqueNetId) return FPlatformMisc::GetPlatformUserForUserIndex(User.Key);
+	}
+	return PLATFORMUSERID_NONE;
+}
+
+#endif
@@ -0,0 +1,305 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoOnlineTrace.h"
+#include "EOSGo.h"
+#include "HAL/FileManager.h"
+#include "UObject/Class.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr uint32 TraceMagic = 0x544F4745; //~ "EGOT"
+	constexpr uint32 TraceVersion = 1;
+	//~ Record tag: event type in the top bits, operation in the low five.
+	constexpr uint8 OperationBits = 5;
+
+	//~ Recording and replaying are development tools; Shipping builds only feed the recorder nobody can start.
+#if !UE_BUILD_SHIPPING
+	TAutoConsoleVariable<float> CVarReplaySpeed(
+		TEXT("EOSGo.Replay.Speed"), 1.f,
+		TEXT("Speed of a -EOSGoReplay trace: 1 keeps the recorded latencies, 10 completes ten times faster, 0 completes on the next tick."));
+
+	FAutoConsoleCommand RecordTraceCommand(
+		TEXT("EOSGo.Trace.Record"),
+		TEXT("EOSGo.Trace.Record [File]: records EOSGo requests and completions to a binary trace (default Saved/EOSGo/Trace-<timestamp>.egotrace)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FGoOnlineTraceRecorder::Get().Start(Args.Num() > 0 ? Args[0] : FString());
+		}));
+
+	FAutoConsoleCommand StopTraceCommand(
+		TEXT("EOSGo.Trace.Stop"),
+		TEXT("Stops recording the EOSGo trace and closes its file."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGoOnlineTraceRecorder::Get().Stop(); }));
+
+	FAutoConsoleCommandWithArgsAndOutputDevice SummarizeTraceCommand(
+		TEXT("EOSGo.Trace.Summary"),
+		TEXT("EOSGo.Trace.Summary <File>: prints latency percentiles, failures and peak concurrency of a recorded EOSGo trace."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+		{
+			TArray<FGoOnlineTraceEvent> Events;
+			if (Args.Num() == 0 || !FGoOnlineTraceRecorder::Load(Args[0], Events))
+			{
+				Ar.Logf(TEXT("EOSGo.Trace.Summary: no readable trace given"));
+				return;
+			}
+			FGoOnlineTraceRecorder::Summarize(Events, Ar);
+		}));
+
+	FAutoConsoleCommand RewindReplayCommand(
+		TEXT("EOSGo.Replay.Rewind"),
+		TEXT("Restarts the -EOSGoReplay trace from its first completion."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGoOnlineTraceReplay::Get().Rewind(); }));
+#endif
+}
+
+
+FGoOnlineTraceRecorder& FGoOnlineTraceRecorder::Get()
+{
+	static FGoOnlineTraceRecorder Recorder;
+	return Recorder;
+}
+bool FGoOnlineTraceRecorder::Start(const FString& InFilename)
+{
+	Stop();
+
+	Filename = InFilename.IsEmpty()
+		? FPaths::ProjectSavedDir() / TEXT("EOSGo") / FString::Printf(TEXT("Trace-%s.egotrace"), *FDateTime::Now().ToString())
+		: InFilename;
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo trace could not be written to %s"), *Filename);
+		return false;
+	}
+
+	uint32 Magic = TraceMagic;
+	uint32 Version = TraceVersion;
+	*Writer << Magic << Version;
+	StartTime = FPlatformTime::Seconds();
+	LastTimeUs = 0;
+	NumEvents = 0;
+	UE_LOG(LogEOSGo, Display, TEXT("Recording EOSGo trace to %s"), *Filename);
+	return true;
+}
+void FGoOnlineTraceRecorder::Stop()
+{
+	if (!Writer.IsValid()) return;
+
+	Writer->Close();
+	Writer.Reset();
+	UE_LOG(LogEOSGo, Display, TEXT("EOSGo trace %s closed with %u event(s)"), *Filename, NumEvents);
+}
+void FGoOnlineTraceRecorder::Record(EGoOnlineTraceEventType Type, EGoOnlineOperation Operation, uint32 Id, bool bWasSuccess, int32 Detail)
+{
+	if (!Writer.IsValid()) return;
+
+	//~ Deltas keep most records at 4-6 bytes; a single gap is capped at ~71 minutes.
+	const uint64 TimeUs = static_cast<uint64>((FPlatformTime::Seconds() - StartTime) * 1000000.0);
+	uint32 DeltaUs = static_cast<uint32>(FMath::Min<uint64>(TimeUs - LastTimeUs, MAX_uint32));
+	LastTimeUs += DeltaUs;
+
+	uint8 Tag = static_cast<uint8>(static_cast<uint8>(Type) << OperationBits | static_cast<uint8>(Operation));
+	*Writer << Tag;
+	Writer->SerializeIntPacked(DeltaUs);
+	Writer->SerializeIntPacked(Id);
+	if (Type == EGoOnlineTraceEventType::End)
+	{
+		uint8 Success = bWasSuccess ? 1 : 0;
+		*Writer << Success;
+	}
+	if (Type != EGoOnlineTraceEventType::Cancel)
+	{
+		uint32 PackedDetail = static_cast<uint32>(FMath::Max(Detail, 0));
+		Writer->SerializeIntPacked(PackedDetail);
+	}
+	++NumEvents;
+}
+
+
+bool FGoOnlineTraceRecorder::Load(const FString& InFilename, TArray<FGoOnlineTraceEvent>& OutEvents)
+{
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InFilename));
+	if (!Reader.IsValid()) return false;
+
+	uint32 Magic = 0, Version = 0;
+	*Reader << Magic << Version;
+	if (Magic != TraceMagic || Version != TraceVersion)
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("%s is not an EOSGo trace of version %u (read magic %08x, version %u)"), *InFilename, TraceVersion, Magic, Version);
+		return false;
+	}
+
+	uint64 TimeUs = 0;
+	while (!Reader->AtEnd() && !Reader->IsError())
+	{
+		uint8 Tag = 0;
+		uint32 DeltaUs = 0;
+		FGoOnlineTraceEvent& Event = OutEvents.AddDefaulted_GetRef();
+		*Reader << Tag;
+		Reader->SerializeIntPacked(DeltaUs);
+		Reader->SerializeIntPacked(Event.Id);
+		Event.Type = static_cast<EGoOnlineTraceEventType>(Tag >> OperationBits);
+		Event.Operation = static_cast<EGoOnlineOperation>(Tag & ((1 << OperationBits) - 1));
+		if (Event.Type == EGoOnlineTraceEventType::End)
+		{
+			uint8 Success = 0;
+			*Reader << Success;
+			Event.bWasSuccess = Success != 0;
+		}
+		if (Event.Type != EGoOnlineTraceEventType::Cancel)
+		{
+			uint32 PackedDetail = 0;
+			Reader->SerializeIntPacked(PackedDetail);
+			Event.Detail = static_cast<int32>(PackedDetail);
+		}
+		TimeUs += DeltaUs;
+		Event.Time = TimeUs / 1000000.0;
+
+		//~ A record cut short (e.g. the process crashed mid-write) or out of range ends the trace.
+		if (Reader->IsError() || Event.Type > EGoOnlineTraceEventType::Cancel || Event.Operation >= EGoOnlineOperation::Count)
+		{
+			OutEvents.Pop(EAllowShrinking::No);
+			break;
+		}
+	}
+	return true;
+}
+void FGoOnlineTraceRecorder::Summarize(const TArray<FGoOnlineTraceEvent>& Events, FOutputDevice& Ar)
+{
+	constexpr int32 NumOperations = static_cast<int32>(EGoOnlineOperation::Count);
+	FGoLatencyHistogram Histograms[NumOperations];
+	uint32 Failures[NumOperations] = {};
+	int32 InFlight[NumOperations] = {};
+	int32 PeakInFlight[NumOperations] = {};
+	TMap<uint32, double> BeginTimes;
+
+	for (const FGoOnlineTraceEvent& Event : Events)
+	{
+		const int32 Index = static_cast<int32>(Event.Operation);
+		switch (Event.Type)
+		{
+		case EGoOnlineTraceEventType::Begin:
+			BeginTimes.Add(Event.Id, Event.Time);
+			PeakInFlight[Index] = FMath::Max(PeakInFlight[Index], ++InFlight[Index]);
+			break;
+		case EGoOnlineTraceEventType::End:
+		{
+			double BeginTime = 0.0;
+			if (!BeginTimes.RemoveAndCopyValue(Event.Id, BeginTime)) break;
+			--InFlight[Index];
+			Histograms[Index].Add((Event.Time - BeginTime) * 1000.0);
+			if (!Event.bWasSuccess) ++Failures[Index];
+			break;
+		}
+		case EGoOnlineTraceEventType::Cancel:
+			if (BeginTimes.Remove(Event.Id) > 0) --InFlight[Index];
+			break;
+		}
+	}
+
+	Ar.Logf(TEXT("EOSGo trace: %d event(s) over %.1fs, %d request(s) never completed"),
+		Events.Num(), Events.IsEmpty() ? 0.0 : Events.Last().Time, BeginTimes.Num());
+	for (int32 Index = 0; Index < NumOperations; ++Index)
+	{
+		const FGoLatencyHistogram& Histogram = Histograms[Index];
+		if (Histogram.Count == 0) continue;
+
+		Ar.Logf(TEXT("  %-18s n=%llu failed=%u peak=%d min=%.1f p50=%.1f p95=%.1f p99=%.1f max=%.1f mean=%.1f"),
+			*StaticEnum<EGoOnlineOperation>()->GetNameStringByValue(Index), Histogram.Count, Failures[Index], PeakInFlight[Index],
+			Histogram.MinMs, Histogram.GetPercentile(0.50f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f),
+			Histogram.MaxMs, Histogram.TotalMs / Histogram.Count);
+	}
+}
+
+
+#if !UE_BUILD_SHIPPING
+FGoOnlineTraceReplay& FGoOnlineTraceReplay::Get()
+{
+	static FGoOnlineTraceReplay Replay;
+	return Replay;
+}
+FGoOnlineTraceReplay::FGoOnlineTraceReplay()
+{
+	FString Filename;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-EOSGoReplay="), Filename)) Load(Filename);
+}
+bool FGoOnlineTraceReplay::Load(const FString& Filename)
+{
+	TArray<FGoOnlineTraceEvent> Events;
+	if (!FGoOnlineTraceRecorder::Load(Filename, Events))
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("EOSGo replay trace %s could not be read"), *Filename);
+		return false;
+	}
+
+	//~ Completions are handed out in request order, so each one takes the slot its Begin reserved.
+	struct FSlot
+	{
+		EGoOnlineOperation Operation;
+		int32 Index;
+	};
+	TMap<uint32, FSlot> Slots;
+	TArray<bool> Completed[NumOperations];
+	TArray<double> BeginTimes[NumOperations];
+	for (int32 Index = 0; Index < NumOperations; ++Index)
+	{
+		Completions[Index].Reset();
+		NextCompletion[Index] = 0;
+	}
+
+	for (const FGoOnlineTraceEvent& Event : Events)
+	{
+		const int32 Operation = static_cast<int32>(Event.Operation);
+		if (Event.Type == EGoOnlineTraceEventType::Begin)
+		{
+			Slots.Add(Event.Id, {Event.Operation, Completions[Operation].AddDefaulted()});
+			Completed[Operation].Add(false);
+			BeginTimes[Operation].Add(Event.Time);
+			continue;
+		}
+
+		//~ The slot belongs to the operation its Begin recorded; an End naming another one is corrupt and dropped.
+		FSlot Slot;
+		if (!Slots.RemoveAndCopyValue(Event.Id, Slot) || Event.Type != EGoOnlineTraceEventType::End || Slot.Operation != Event.Operation) continue;
+		FCompletion& Completion = Completions[Operation][Slot.Index];
+		Completion.LatencySeconds = Event.Time - BeginTimes[Operation][Slot.Index];
+		Completion.bWasSuccess = Event.bWasSuccess;
+		Completion.Detail = Event.Detail;
+		Completed[Operation][Slot.Index] = true;
+	}
+
+	//~ Cancelled and never completed requests were never seen by the caller: drop them.
+	int32 NumCompletions = 0;
+	for (int32 Operation = 0; Operation < NumOperations; ++Operation)
+	{
+		int32 Kept = 0;
+		for (int32 Index = 0; Index < Completions[Operation].Num(); ++Index)
+		{
+			if (Completed[Operation][Index]) Completions[Operation][Kept++] = Completions[Operation][Index];
+		}
+		Completions[Operation].SetNum(Kept);
+		NumCompletions += Kept;
+	}
+
+	bIsActive = true;
+	UE_LOG(LogEOSGo, Display, TEXT("Replaying %d completion(s) from EOSGo trace %s"), NumCompletions, *Filename);
+	return true;
+}
+bool FGoOnlineTraceReplay::Take(EGoOnlineOperation Operation, FCompletion& OutCompletion)
+{
+	const int32 Index = static_cast<int32>(Operation);
+	if (!bIsActive || Index < 0 || Index >= NumOperations || NextCompletion[Index] >= Completions[Index].Num()) return false;
+
+	OutCompletion = Completions[Index][NextCompletion[Index]++];
+	const float Speed = CVarReplaySpeed.GetValueOnGameThread();
+	OutCompletion.LatencySeconds = Speed > 0.f ? OutCompletion.LatencySeconds / Speed : 0.0;
+	return true;
+}
+void FGoOnlineTraceReplay::Rewind()
+{
+	for (int32 Index = 0; Index < NumOperations; ++Index) NextCompletion[Index] = 0;
+}
+#endif
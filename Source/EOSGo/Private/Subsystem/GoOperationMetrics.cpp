@@ -0,0 +1,211 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoOperationMetrics.h"
+#include "Subsystem/GoOnlineTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "Trace/Trace.inl"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Operations In Flight"), STAT_EOSGo_OperationsInFlight, STATGROUP_EOSGo);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Failed Operations"), STAT_EOSGo_FailedOperations, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Login (ms)"), STAT_EOSGo_LoginLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Create (ms)"), STAT_EOSGo_CreateLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Find (ms)"), STAT_EOSGo_FindLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Join (ms)"), STAT_EOSGo_JoinLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Start (ms)"), STAT_EOSGo_StartLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Update (ms)"), STAT_EOSGo_UpdateLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Destroy (ms)"), STAT_EOSGo_DestroyLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last RegisterPlayers (ms)"), STAT_EOSGo_RegisterPlayersLatency, STATGROUP_EOSGo);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last UnregisterPlayers (ms)"), STAT_EOSGo_UnregisterPlayersLatency, STATGROUP_EOSGo);
+
+//~ Enable with -trace=EOSGo (or "Trace.Enable EOSGo"); pair events by Id.
+UE_TRACE_CHANNEL_DEFINE(EOSGoChannel)
+
+UE_TRACE_EVENT_BEGIN(EOSGo, OperationBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, Id)
+	UE_TRACE_EVENT_FIELD(uint8, Operation)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(EOSGo, OperationEnd)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, Id)
+	UE_TRACE_EVENT_FIELD(uint8, Operation)
+	UE_TRACE_EVENT_FIELD(bool, bWasSuccess)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	const TCHAR* GetOperationName(EGoOnlineOperation Operation)
+	{
+		switch (Operation)
+		{
+		case EGoOnlineOperation::Login: return TEXT("Login");
+		case EGoOnlineOperation::Create: return TEXT("Create");
+		case EGoOnlineOperation::Find: return TEXT("Find");
+		case EGoOnlineOperation::Join: return TEXT("Join");
+		case EGoOnlineOperation::Start: return TEXT("Start");
+		case EGoOnlineOperation::Update: return TEXT("Update");
+		case EGoOnlineOperation::Destroy: return TEXT("Destroy");
+		case EGoOnlineOperation::RegisterPlayers: return TEXT("RegisterPlayers");
+		case EGoOnlineOperation::UnregisterPlayers: return TEXT("UnregisterPlayers");
+		default: return TEXT("Unknown");
+		}
+	}
+
+#if STATS
+	FName GetLatencyStatName(EGoOnlineOperation Operation)
+	{
+		switch (Operation)
+		{
+		case EGoOnlineOperation::Login: return GET_STATFNAME(STAT_EOSGo_LoginLatency);
+		case EGoOnlineOperation::Create: return GET_STATFNAME(STAT_EOSGo_CreateLatency);
+		case EGoOnlineOperation::Find: return GET_STATFNAME(STAT_EOSGo_FindLatency);
+		case EGoOnlineOperation::Join: return GET_STATFNAME(STAT_EOSGo_JoinLatency);
+		case EGoOnlineOperation::Start: return GET_STATFNAME(STAT_EOSGo_StartLatency);
+		case EGoOnlineOperation::Update: return GET_STATFNAME(STAT_EOSGo_UpdateLatency);
+		case EGoOnlineOperation::Destroy: return GET_STATFNAME(STAT_EOSGo_DestroyLatency);
+		case EGoOnlineOperation::RegisterPlayers: return GET_STATFNAME(STAT_EOSGo_RegisterPlayersLatency);
+		case EGoOnlineOperation::UnregisterPlayers: return GET_STATFNAME(STAT_EOSGo_UnregisterPlayersLatency);
+		default: return NAME_None;
+		}
+	}
+#endif
+
+	FAutoConsoleCommandWithOutputDevice DumpMetricsCommand(
+		TEXT("EOSGo.Metrics.Dump"),
+		TEXT("Prints request-to-completion latency percentiles of EOSGo online operations."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar) { FGoOperationMetrics::Get().Dump(Ar); }));
+
+	FAutoConsoleCommand ResetMetricsCommand(
+		TEXT("EOSGo.Metrics.Reset"),
+		TEXT("Clears the recorded latencies of EOSGo online operations."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGoOperationMetrics::Get().Reset(); }));
+}
+
+
+int32 FGoLatencyHistogram::GetBucketIndex(double Milliseconds)
+{
+	if (Milliseconds <= 1.0) return 0;
+	const int32 Index = FMath::CeilToInt32(FMath::Log2(Milliseconds) * BucketsPerOctave) - 1;
+	return FMath::Clamp(Index, 0, NumBuckets - 1);
+}
+double FGoLatencyHistogram::GetBucketUpperBound(int32 Index)
+{
+	return FMath::Pow(2.0, static_cast<double>(Index + 1) / BucketsPerOctave);
+}
+void FGoLatencyHistogram::Add(double Milliseconds)
+{
+	MinMs = Count == 0 ? Milliseconds : FMath::Min(MinMs, Milliseconds);
+	MaxMs = Count == 0 ? Milliseconds : FMath::Max(MaxMs, Milliseconds);
+	TotalMs += Milliseconds;
+	++Count;
+	++Buckets[GetBucketIndex(Milliseconds)];
+}
+double FGoLatencyHistogram::GetPercentile(float Percentile) const
+{
+	if (Count == 0) return 0.0;
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.f, 1.f) * Count)));
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Buckets[Index];
+		//~ Report the bucket's upper bound, kept within the observed range.
+		if (Seen >= Rank) return FMath::Clamp(GetBucketUpperBound(Index), MinMs, MaxMs);
+	}
+	return MaxMs;
+}
+void FGoLatencyHistogram::Reset()
+{
+	*this = FGoLatencyHistogram();
+}
+
+
+FGoOperationMetrics& FGoOperationMetrics::Get()
+{
+	static FGoOperationMetrics Metrics;
+	return Metrics;
+}
+void FGoOperationMetrics::Begin(EGoOnlineOperation Operation, int32 Detail, FName Key)
+{
+	const uint32 Id = NextId++;
+	Pending[static_cast<int32>(Operation)].Add({Id, Key, FPlatformTime::Seconds()});
+	INC_DWORD_STAT(STAT_EOSGo_OperationsInFlight);
+	FGoOnlineTraceRecorder::Get().Record(EGoOnlineTraceEventType::Begin, Operation, Id, false, Detail);
+
+	UE_TRACE_LOG(EOSGo, OperationBegin, EOSGoChannel)
+		<< OperationBegin.Cycle(FPlatformTime::Cycles64())
+		<< OperationBegin.Id(Id)
+		<< OperationBegin.Operation(static_cast<uint8>(Operation));
+}
+void FGoOperationMetrics::End(EGoOnlineOperation Operation, bool bWasSuccess, int32 Detail, FName Key)
+{
+	const int32 Index = static_cast<int32>(Operation);
+	//~ Completions without a matching Begin (e.g. broadcast before the request was issued) are not timed.
+	const int32 StartedIndex = Pending[Index].IndexOfByPredicate([Key](const FPendingOperation& PendingOperation) { return PendingOperation.Key == Key; });
+	if (StartedIndex == INDEX_NONE) return;
+
+	const FPendingOperation Started = Pending[Index][StartedIndex];
+	Pending[Index].RemoveAt(StartedIndex, 1, EAllowShrinking::No);
+	DEC_DWORD_STAT(STAT_EOSGo_OperationsInFlight);
+
+	FGoOnlineTraceRecorder::Get().Record(EGoOnlineTraceEventType::End, Operation, Started.Id, bWasSuccess, Detail);
+
+	const double Milliseconds = (FPlatformTime::Seconds() - Started.StartTime) * 1000.0;
+	Histograms[Index].Add(Milliseconds);
+	if (!bWasSuccess)
+	{
+		++Failures[Index];
+		INC_DWORD_STAT(STAT_EOSGo_FailedOperations);
+	}
+#if STATS
+	SET_FLOAT_STAT_FName(GetLatencyStatName(Operation), Milliseconds);
+#endif
+
+	UE_TRACE_LOG(EOSGo, OperationEnd, EOSGoChannel)
+		<< OperationEnd.Cycle(FPlatformTime::Cycles64())
+		<< OperationEnd.Id(Started.Id)
+		<< OperationEnd.Operation(static_cast<uint8>(Operation))
+		<< OperationEnd.bWasSuccess(bWasSuccess);
+}
+void FGoOperationMetrics::Cancel(EGoOnlineOperation Operation, FName Key)
+{
+	TArray<FPendingOperation, TInlineAllocator<4>>& Operations = Pending[static_cast<int32>(Operation)];
+	const int32 CancelledIndex = Operations.FindLastByPredicate([Key](const FPendingOperation& PendingOperation) { return PendingOperation.Key == Key; });
+	if (CancelledIndex == INDEX_NONE) return;
+
+	const FPendingOperation Cancelled = Operations[CancelledIndex];
+	Operations.RemoveAt(CancelledIndex, 1, EAllowShrinking::No);
+	DEC_DWORD_STAT(STAT_EOSGo_OperationsInFlight);
+	FGoOnlineTraceRecorder::Get().Record(EGoOnlineTraceEventType::Cancel, Operation, Cancelled.Id);
+}
+const FGoLatencyHistogram& FGoOperationMetrics::GetHistogram(EGoOnlineOperation Operation) const
+{
+	return Histograms[FMath::Clamp(static_cast<int32>(Operation), 0, NumOperations - 1)];
+}
+uint32 FGoOperationMetrics::GetFailureCount(EGoOnlineOperation Operation) const
+{
+	return Failures[FMath::Clamp(static_cast<int32>(Operation), 0, NumOperations - 1)];
+}
+void FGoOperationMetrics::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("EOSGo operation latency (ms):"));
+	for (int32 Index = 0; Index < NumOperations; ++Index)
+	{
+		const FGoLatencyHistogram& Histogram = Histograms[Index];
+		if (Histogram.Count == 0) continue;
+
+		Ar.Logf(TEXT("  %-18s n=%llu failed=%u min=%.1f p50=%.1f p95=%.1f p99=%.1f max=%.1f mean=%.1f"),
+			GetOperationName(static_cast<EGoOnlineOperation>(Index)), Histogram.Count, Failures[Index],
+			Histogram.MinMs, Histogram.GetPercentile(0.50f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f),
+			Histogram.MaxMs, Histogram.TotalMs / Histogram.Count);
+	}
+}
+void FGoOperationMetrics::Reset()
+{
+	for (int32 Index = 0; Index < NumOperations; ++Index)
+	{
+		Histograms[Index].Reset();
+		Failures[Index] = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoSessionAttributes.h"
+
+namespace EOSGo::SessionAttributes
+{
+	const TGoSessionAttribute<FString> MatchType(TEXT("MATCH_TYPE"));
+	const TGoSessionAttribute<bool> IsPrivate(TEXT("SERVER_IS_PRIVATE"));
+	const TGoSessionAttribute<int64> ServerJoinId(TEXT("SERVER_JOIN_ID"));
+	const TGoSessionAttribute<FString> HostSessionName(TEXT("HOST_SESSION_NAME"));
+	const TGoSessionAttribute<int32> BeaconPort(TEXT("BEACONPORT"));
+}
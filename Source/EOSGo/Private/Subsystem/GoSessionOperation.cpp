@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoSessionOperation.h"
+#include "OnlineSessionSettings.h"
+
+bool FGoSessionOperation::ChangesSessionLifecycle() const
+{
+	return Type == EGoSessionOperationType::Create || Type == EGoSessionOperationType::Join || Type == EGoSessionOperationType::Destroy;
+}
+
+bool FGoSessionOperation::ConflictsWith(EGoSessionOperationType OtherType) const
+{
+	//~ Create, Join and Destroy need the session to themselves.
+	if (ChangesSessionLifecycle()) return true;
+	if (OtherType == EGoSessionOperationType::Create || OtherType == EGoSessionOperationType::Join || OtherType == EGoSessionOperationType::Destroy) return true;
+
+	//~ Update and Start act on an existing session and can overlap each other, but not themselves.
+	return Type == OtherType;
+}
+
+
+bool FGoSessionOperationQueue::Enqueue(FGoSessionOperation&& Operation)
+{
+	//~ Look back to the session's last lifecycle change; anything past it acts on a different session.
+	bool bIsLatestOfSession = true;
+	for (int32 Index = Operations.Num() - 1; Index >= 0; --Index)
+	{
+		FGoSessionOperation& Queued = Operations[Index];
+		if (Queued.SessionName != Operation.SessionName) continue;
+		if (Queued.Type == Operation.Type)
+		{
+			switch (Operation.Type)
+			{
+			case EGoSessionOperationType::Update:
+				//~ Only the latest settings matter.
+				Queued.UpdateSettings = MoveTemp(Operation.UpdateSettings);
+				Queued.Requests.Append(MoveTemp(Operation.Requests));
+				return false;
+			case EGoSessionOperationType::Start:
+			case EGoSessionOperationType::Destroy:
+				Queued.Requests.Append(MoveTemp(Operation.Requests));
+				return false;
+			case EGoSessionOperationType::Create:
+			case EGoSessionOperationType::Join:
+				//~ Back to back requests for a new session: the latest one wins, and answers both requesters.
+				if (bIsLatestOfSession)
+				{
+					Operation.Requests.Insert(MoveTemp(Queued.Requests), 0);
+					Operation.bIsAfterDestroy = Queued.bIsAfterDestroy;
+					Queued = MoveTemp(Operation);
+					return false;
+				}
+				break;
+			}
+		}
+		if (Queued.ChangesSessionLifecycle()) break;
+		bIsLatestOfSession = false;
+	}
+
+	Operations.Add(MoveTemp(Operation));
+	return true;
+}
+
+void FGoSessionOperationQueue::PushFront(FGoSessionOperation&& Operation)
+{
+	Operations.Insert(MoveTemp(Operation), 0);
+}
+
+bool FGoSessionOperationQueue::PopReady(const TArray<FGoInFlightSessionOperation>& InFlight, FGoSessionOperation& OutOperation)
+{
+	//~ A blocked session keeps its later operations queued, without holding back other sessions.
+	TArray<FName, TInlineAllocator<4>> BlockedSessions;
+	for (int32 Index = 0; Index < Operations.Num(); ++Index)
+	{
+		const FGoSessionOperation& Queued = Operations[Index];
+		if (BlockedSessions.Contains(Queued.SessionName)) continue;
+
+		const bool bConflicts = InFlight.ContainsByPredicate([&Queued](const FGoInFlightSessionOperation& InFlightOperation)
+		{
+			return InFlightOperation.SessionName == Queued.SessionName && Queued.ConflictsWith(InFlightOperation.Type);
+		});
+		if (bConflicts)
+		{
+			BlockedSessions.Add(Queued.SessionName);
+			continue;
+		}
+
+		OutOperation = MoveTemp(Operations[Index]);
+		Operations.RemoveAt(Index);
+		return true;
+	}
+	return false;
+}
+
+bool FGoSessionOperationQueue::TakeRequest(int32 RequestId, FGoRequest& OutRequest, FName& OutSessionName)
+{
+	for (int32 Index = 0; Index < Operations.Num(); ++Index)
+	{
+		FGoSessionOperation& Queued = Operations[Index];
+		if (!TakeGoRequest(Queued.Requests, RequestId, OutRequest)) continue;
+
+		//~ Nobody waits for it anymore: it's dropped before reaching the backend.
+		OutSessionName = Queued.SessionName;
+		if (Queued.Requests.IsEmpty()) Operations.RemoveAt(Index);
+		return true;
+	}
+	return false;
+}
+
+TArray<FGoRequest> FGoSessionOperationQueue::TakeAllRequests()
+{
+	TArray<FGoRequest> Requests;
+	for (FGoSessionOperation& Queued : Operations)
+	{
+		Requests.Append(MoveTemp(Queued.Requests));
+		Queued.Requests.Reset();
+	}
+	return Requests;
+}
+
+bool FGoSessionOperationQueue::Contains(EGoSessionOperationType Type, FName SessionName) const
+{
+	return Operations.ContainsByPredicate([Type, SessionName](const FGoSessionOperation& Queued) { return Queued.Type == Type && Queued.SessionName == SessionName; });
+}
\ No newline at end of file
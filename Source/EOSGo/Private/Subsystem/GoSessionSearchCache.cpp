@@ -0,0 +1,30 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoSessionSearchCache.h"
+#include "OnlineSessionSettings.h"
+
+TSharedPtr<FOnlineSessionSearch> FGoSessionSearchCache::Find(const FGoSessionSearchQuery& Query, float TimeToLive)
+{
+	const FEntry* Entry = Entries.Find(Query);
+	if (!Entry) return nullptr;
+
+	//~ Drop expired entries as they are found.
+	if (FPlatformTime::Seconds() - Entry->CompletedTime >= TimeToLive)
+	{
+		Entries.Remove(Query);
+		return nullptr;
+	}
+	return Entry->Search;
+}
+
+void FGoSessionSearchCache::Add(const FGoSessionSearchQuery& Query, const TSharedRef<FOnlineSessionSearch>& Search)
+{
+	FEntry& Entry = Entries.FindOrAdd(Query);
+	Entry.Search = Search;
+	Entry.CompletedTime = FPlatformTime::Seconds();
+}
+
+void FGoSessionSearchCache::Invalidate()
+{
+	Entries.Empty();
+}
\ No newline at end of file
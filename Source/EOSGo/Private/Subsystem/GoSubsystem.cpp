@@ -1,13 +1,21 @@
 // Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
 
 #include "Subsystem/GoSubsystem.h"
+#include "Subsystem/GoOperationMetrics.h"
+#include "Subsystem/GoMockOnlineBackend.h"
+#include "Subsystem/GoSessionAttributes.h"
+#include "Subsystem/GoJoinCode.h"
+#include "Game/GoReservationBeacon.h"
 #include "EOSGo.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineSessionSettings.h"
+#include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
 
 UGoSubsystem::UGoSubsystem() :
 /*Bind Delegates*/
@@ -19,13 +27,58 @@ JoinSessionCompleteDelegate(FOnJoinSessionCompleteDelegate::CreateUObject(this,
 DestroySessionCompleteDelegate(FOnDestroySessionCompleteDelegate::CreateUObject(this, &ThisClass::OnDestroySessionComplete)),
 StartSessionCompleteDelegate(FOnStartSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnStartSessionComplete))
 {
+	//~ Default match types, overridable from config.
+	auto AddMatchType = [this](FName Name, int32 MaxPlayers)
+	{
+		FGoMatchTypeDefinition& Definition = MatchTypes.AddDefaulted_GetRef();
+		Definition.Name = Name;
+		Definition.MaxPlayers = MaxPlayers;
+	};
+	AddMatchType(FName("DUO"), 2);
+	AddMatchType(FName("TRIO"), 3);
+	AddMatchType(FName("SQUAD"), 4);
+}
+
+void UGoSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	//~ Online interfaces are acquired here rather than in the constructor, which also runs for the class default object.
+	Identity = EOSGo::GetIdentityInterface();
+	SessionInterface = EOSGo::GetSessionInterface();
+#if !UE_BUILD_SHIPPING
+	if (FGoMockOnlineBackend::IsEnabled())
+	{
+		UE_LOG(LogEOSGo, Log, TEXT("Mock online backend enabled"));
+	}
+	else
+#endif
 	if (IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get())
 	{
-		LogMessage("Subsystem is loaded!");
-		Identity = Subsystem->GetIdentityInterface();
-		SessionInterface = Subsystem->GetSessionInterface();
+		UE_LOG(LogEOSGo, Log, TEXT("Online subsystem %s loaded"), *Subsystem->GetSubsystemName().ToString());
 		UserInterface = Subsystem->GetUserInterface();
 	}
+
+	MatchTypeRegistry.Build(MatchTypes);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMap);
+
+	//~ Log in while the main menu loads instead of waiting for the login button.
+	if (bAutoLoginOnStartup && !IsRunningDedicatedServer())
+	{
+		GoAutoLogin();
+	}
+}
+void UGoSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	ReleasePreloadedMap();
+	for (TPair<FName, FGoPendingSlotReservation>& Pending : PendingSlotReservations)
+	{
+		if (AGoReservationBeaconClient* Beacon = Pending.Value.Beacon.Get()) Beacon->DestroyBeacon();
+	}
+	PendingSlotReservations.Reset();
+	CancelAllRequests();
+	Super::Deinitialize();
 }
 
 
@@ -33,32 +86,65 @@ void UGoSubsystem::OnLoginComplete(int32 LocalUserNum, bool bWasSuccess, const F
 {
 	//~ If Login was successful, clear delegate of the delegate list.
 	if (Identity) Identity->ClearOnLoginCompleteDelegate_Handle(LocalUserNum, LoginCompleteDelegateHandle);
+	bIsLoginInProgress = false;
+	//~ The player's request is answered by this login, or by the account portal login it falls back to.
+	const bool bWasInteractiveLoginRequested = bInteractiveLoginRequested;
+	bInteractiveLoginRequested = false;
 
-	//~ Broadcast Go Subsystem Delegate - Login was successful.
-	User = UserInterface->GetUserInfo(LocalUserNum, UserId);
-	
-	if (Identity->GetLoginStatus(LocalUserNum) == ELoginStatus::LoggedIn)
+	const bool bIsLoggedIn = Identity && Identity->GetLoginStatus(LocalUserNum) == ELoginStatus::LoggedIn;
+	FGoOperationMetrics::Get().End(EGoOnlineOperation::Login, bIsLoggedIn);
+	if (bIsLoggedIn)
 	{
-		LoggedPlayerUsername = FName(User->GetDisplayName(FString("Epic")));
+		//~ Broadcast Go Subsystem Delegate - Login was successful.
+		//~ Without a user interface (mock backend) the identity's nickname is used.
+		User = UserInterface ? UserInterface->GetUserInfo(LocalUserNum, UserId) : nullptr;
+		LoggedPlayerUsername = User.IsValid() ? FName(User->GetDisplayName(FString("Epic")))
+			: UserInterface ? FName("Unknown") : FName(Identity->GetPlayerNickname(UserId));
+		bIsBackgroundLogin = false;
 		GoOnLoginComplete.Broadcast(LoggedPlayerUsername);
-		LogMessage("Login Successful");
+		UE_LOG(LogEOSGoAuth, Log, TEXT("Login successful"));
+		CompleteLoginRequests(true);
+		return;
+	}
+
+	//~ A failed background login stays silent unless the player asked to log in meanwhile.
+	if (bIsBackgroundLogin)
+	{
+		bIsBackgroundLogin = false;
+		UE_LOG(LogEOSGoAuth, Log, TEXT("Background login failed (%s), waiting for interactive login"), *Error);
+		CompleteGoRequests(BackgroundLoginRequests, false, NAME_None, 0);
+		if (bWasInteractiveLoginRequested) StartLogin("", "", "accountportal", FGoRequest());
+		return;
 	}
+
+	//~ Broadcast Go Subsystem Delegate - Login wasn't successful.
+	UE_LOG(LogEOSGoAuth, Warning, TEXT("Login failed: %s"), *Error);
+	GoOnLoginComplete.Broadcast(FName("Unknown"));
+	CompleteLoginRequests(false);
 }
-void UGoSubsystem::GoEOSLogin(FString Id, FString Token, FString LoginType)
+void UGoSubsystem::CompleteLoginRequests(bool bWasSuccess)
 {
-	if(!Identity.IsValid()) return;
-
-	//~ Player validations.
-	const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController();
-	if (!LocalPlayer)
+	CompleteGoRequests(BackgroundLoginRequests, bWasSuccess, NAME_None, 0);
+	CompleteGoRequests(LoginRequests, bWasSuccess, NAME_None, 0);
+}
+int32 UGoSubsystem::GoEOSLogin(const FString& Id, const FString& Token, const FString& LoginType, FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	StartLogin(Id, Token, LoginType, MoveTemp(Request));
+	return RequestId;
+}
+void UGoSubsystem::StartLogin(const FString& Id, const FString& Token, const FString& LoginType, FGoRequest&& Request)
+{
+	if(!Identity.IsValid())
 	{
-		LogMessage("LocalPlayer on searching is invalid!");
-		GoOnLoginComplete.Broadcast(FName("Unknown"));
+		Request.Complete(false, NAME_None, 0);
 		return;
 	}
+	(bIsBackgroundLogin ? BackgroundLoginRequests : LoginRequests).Add(MoveTemp(Request));
 
 	//~ Get Player Local User Number.
-	int32 LocalUserNumber = LocalPlayer->GetControllerId();
+	const int32 LocalUserNumber = GetLocalUserNum();
 
 	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
 	LoginCompleteDelegateHandle = Identity->AddOnLoginCompleteDelegate_Handle(LocalUserNumber, LoginCompleteDelegate);
@@ -70,14 +156,116 @@ void UGoSubsystem::GoEOSLogin(FString Id, FString Token, FString LoginType)
 	AccountDetails.Type = LoginType;
 	
 	//~ LOGIN
+	bIsLoginInProgress = true;
+	FGoOperationMetrics::Get().Begin(EGoOnlineOperation::Login);
 	if (!Identity->Login(LocalUserNumber, AccountDetails))
 	{
-		LogMessage("Login Failed");
+		FGoOperationMetrics::Get().End(EGoOnlineOperation::Login, false);
+		UE_LOG(LogEOSGoAuth, Warning, TEXT("Login (%s) could not be started"), *LoginType);
+		bIsLoginInProgress = false;
+		bIsBackgroundLogin = false;
+		bInteractiveLoginRequested = false;
 		//~ If Login wasn't successful, clear delegate of the delegate list.
 		Identity->ClearOnLoginCompleteDelegate_Handle(LocalUserNumber, LoginCompleteDelegateHandle);
 		//~ Broadcast Go Subsystem Delegate - Login wasn't successful.
 		GoOnLoginComplete.Broadcast(FName("Unknown"));
+		CompleteLoginRequests(false);
+	}
+}
+int32 UGoSubsystem::GoAutoLogin()
+{
+	return GoAutoLogin(FGoOnRequestComplete());
+}
+int32 UGoSubsystem::GoAutoLogin(FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	if (!Identity.IsValid() || IsPlayerLoggedIn())
+	{
+		Request.Complete(IsPlayerLoggedIn(), NAME_None, 0);
+		return RequestId;
+	}
+	//~ A login is already running: the request shares its outcome.
+	if (bIsLoginInProgress)
+	{
+		(bIsBackgroundLogin ? BackgroundLoginRequests : LoginRequests).Add(MoveTemp(Request));
+		return RequestId;
+	}
+
+	//~ Credentials passed on the command line win; otherwise reuse the refresh token stored by a previous login.
+	FString Id, Token, LoginType;
+	if (!GetCommandLineCredentials(Id, Token, LoginType))
+	{
+		LoginType = TEXT("persistentauth");
+	}
+	bIsBackgroundLogin = true;
+	StartLogin(Id, Token, LoginType, MoveTemp(Request));
+	return RequestId;
+}
+int32 UGoSubsystem::GoInteractiveLogin()
+{
+	return GoInteractiveLogin(FGoOnRequestComplete());
+}
+int32 UGoSubsystem::GoInteractiveLogin(FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	if (!Identity.IsValid())
+	{
+		Request.Complete(false, NAME_None, 0);
+		return RequestId;
+	}
+
+	//~ Already logged in (usually by the background login): report it right away.
+	if (IsPlayerLoggedIn())
+	{
+		GoOnLoginComplete.Broadcast(LoggedPlayerUsername);
+		Request.Complete(true, NAME_None, 0);
+		return RequestId;
+	}
+
+	//~ The background login is still running; it falls back to the account portal if it fails.
+	bInteractiveLoginRequested = true;
+	if (bIsLoginInProgress)
+	{
+		LoginRequests.Add(MoveTemp(Request));
+		return RequestId;
+	}
+
+	FString Id, Token, LoginType;
+	if (GetCommandLineCredentials(Id, Token, LoginType))
+	{
+		StartLogin(Id, Token, LoginType, MoveTemp(Request));
+		return RequestId;
+	}
+	StartLogin("", "", "accountportal", MoveTemp(Request));
+	return RequestId;
+}
+bool UGoSubsystem::GetCommandLineCredentials(FString& OutId, FString& OutToken, FString& OutLoginType)
+{
+	const bool bFound = FParse::Value(FCommandLine::Get(), TEXT("-AUTH_TYPE="), OutLoginType)
+		&& FParse::Value(FCommandLine::Get(), TEXT("-AUTH_TOKEN="), OutToken)
+		&& FParse::Value(FCommandLine::Get(), TEXT("-AUTH_ID="), OutId)
+		&& !OutLoginType.IsEmpty() && !OutToken.IsEmpty() && !OutId.IsEmpty();
+
+	//~ Never log the token itself.
+	if (bFound)
+	{
+		UE_LOG(LogEOSGoAuth, Verbose, TEXT("Login auth data retrieved: AUTH_TYPE=%s | AUTH_TOKEN=%s | AUTH_ID=%s"),
+			*OutLoginType, *EOSGo::RedactCredential(OutToken), *EOSGo::RedactCredential(OutId));
 	}
+	return bFound;
+}
+int32 UGoSubsystem::GetLocalUserNum() const
+{
+	//~ Before the first local player exists (e.g. during startup login) the primary user is 0.
+	const UGameInstance* GameInstance = GetGameInstance();
+	const ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->GetFirstGamePlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetControllerId() : 0;
+}
+FUniqueNetIdPtr UGoSubsystem::GetLocalUserId() const
+{
+	return Identity.IsValid() ? Identity->GetUniquePlayerId(GetLocalUserNum()) : nullptr;
 }
 
 
@@ -85,8 +273,7 @@ bool UGoSubsystem::IsPlayerLoggedIn()
 {
 	if(!Identity.IsValid()) return false;
 
-	const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController();
-	return Identity->GetLoginStatus(LocalPlayer->GetControllerId()) == ELoginStatus::LoggedIn;
+	return Identity->GetLoginStatus(GetLocalUserNum()) == ELoginStatus::LoggedIn;
 }
 FName UGoSubsystem::GetPlayerUsername()
 {
@@ -94,261 +281,1569 @@ FName UGoSubsystem::GetPlayerUsername()
 }
 
 
+float UGoSubsystem::GetOperationLatencyPercentile(EGoOnlineOperation Operation, float Percentile) const
+{
+	return static_cast<float>(FGoOperationMetrics::Get().GetHistogram(Operation).GetPercentile(Percentile));
+}
+int32 UGoSubsystem::GetOperationCount(EGoOnlineOperation Operation) const
+{
+	return static_cast<int32>(FGoOperationMetrics::Get().GetHistogram(Operation).Count);
+}
+
+
+bool UGoSubsystem::GetMatchTypeDefinition(FName MatchType, FGoMatchTypeDefinition& OutDefinition) const
+{
+	const FGoMatchType* Found = MatchTypeRegistry.Find(MatchType);
+	if (!Found) return false;
+
+	OutDefinition = Found->Definition;
+	return true;
+}
+
+
+EGoSessionState UGoSubsystem::GetNamedSessionState(FName SessionName) const
+{
+	const FGoNamedSession* Session = NamedSessions.Find(SessionName);
+	return Session ? Session->State : EGoSessionState::None;
+}
+TArray<FName> UGoSubsystem::GetSessionNames() const
+{
+	TArray<FName> SessionNames;
+	for (const TPair<FName, FGoNamedSession>& Session : NamedSessions)
+	{
+		if (Session.Value.State != EGoSessionState::None) SessionNames.Add(Session.Key);
+	}
+	return SessionNames;
+}
+const FGoMatchType* UGoSubsystem::GetCurrentMatchType(FName SessionName) const
+{
+	const FGoNamedSession* Session = NamedSessions.Find(SessionName);
+	return Session ? MatchTypeRegistry.Find(Session->MatchType) : nullptr;
+}
+
+
 void UGoSubsystem::OnCreateSessionComplete(FName SessionName, bool bWasSuccess)
 {
-	//~ If session was created, clear delegate of the delegate list.
-	if (SessionInterface) SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
-	
+	if (!IsSessionOperationInFlight(SessionName, EGoSessionOperationType::Create)) return;
+
+	//~ If every creation has completed, clear delegate of the delegate list.
+	if (SessionInterface && GetNumInFlightSessionOperations(EGoSessionOperationType::Create) <= 1)
+	{
+		SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
+	}
+
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+	Session.State = bWasSuccess ? EGoSessionState::Pending : EGoSessionState::None;
+	if (!bWasSuccess)
+	{
+		if (SessionName == NAME_GameSession) ServerJoinId = 0;
+		Session.MatchType = NAME_None;
+	}
+
 	//~ Broadcast Go Subsystem Delegate - Creation successful.
+	BroadcastCreateSessionComplete(SessionName, bWasSuccess);
+	FinishSessionOperation(SessionName, EGoSessionOperationType::Create, bWasSuccess);
+}
+void UGoSubsystem::BroadcastCreateSessionComplete(FName SessionName, bool bWasSuccess)
+{
+	if (SessionName != NAME_GameSession) return;
+
 	GoOnCreateSessionComplete.Broadcast(bWasSuccess);
 }
-void UGoSubsystem::GoCreateSession(int32 NumberOfConnections, FString MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession)
+int32 UGoSubsystem::GoCreateSession(int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession, FName SessionName,
+	FGoOnRequestComplete OnComplete)
 {
-    if (!SessionInterface.IsValid()) return;
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Create;
+	Operation.SessionName = SessionName;
+	Operation.NumberOfConnections = NumberOfConnections;
+	Operation.MatchType = FName(MatchType);
+	Operation.ServerPrivateJoinId = ServerPrivateJoinId;
+	Operation.bIsPrivateSession = bIsPrivateSession;
+	return RequestSessionOperation(MoveTemp(Operation), MoveTemp(OnComplete));
+}
+int32 UGoSubsystem::GoHostDedicatedSession(FName MatchType, int32 NumberOfConnections)
+{
+	return GoHostDedicatedSession(MatchType, NumberOfConnections, FGoOnRequestComplete());
+}
+int32 UGoSubsystem::GoHostDedicatedSession(FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete OnComplete)
+{
+	return HostDedicatedSession(NAME_GameSession, MatchType, NumberOfConnections, MoveTemp(OnComplete));
+}
+FName UGoSubsystem::GoHostDedicatedLobby(FName MatchType, int32 NumberOfConnections)
+{
+	FName SessionName;
+	GoHostDedicatedLobby(MatchType, NumberOfConnections, FGoOnRequestComplete(), SessionName);
+	return SessionName;
+}
+int32 UGoSubsystem::GoHostDedicatedLobby(FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete OnComplete, FName& OutSessionName)
+{
+	OutSessionName = FName(*FString::Printf(TEXT("GoLobby_%d"), NextDedicatedLobbyIndex++));
+	return HostDedicatedSession(OutSessionName, MatchType, NumberOfConnections, MoveTemp(OnComplete));
+}
+int32 UGoSubsystem::HostDedicatedSession(FName SessionName, FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete&& OnComplete)
+{
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Create;
+	Operation.SessionName = SessionName;
+	Operation.NumberOfConnections = NumberOfConnections;
+	Operation.MatchType = MatchType;
+	Operation.bIsDedicated = true;
+	return RequestSessionOperation(MoveTemp(Operation), MoveTemp(OnComplete));
+}
+void UGoSubsystem::ExecuteCreateSession(FGoSessionOperation&& Operation)
+{
+	const FName SessionName = Operation.SessionName;
 
-    auto ExistingSession = SessionInterface->GetNamedSession(NAME_GameSession);
-	//~ If same named session exists, it will be deleted.
-    if (ExistingSession != nullptr)
-    {
-        bCreateSessionOnDestroy = true;
-        bCreatePrivateSession = bIsPrivateSession;
-        LastServerPrivateJoinId = ServerPrivateJoinId;
-        LastNumberOfPublicConnections = NumberOfConnections;
-        LastMatchType = MatchType;
-        GoDestroySession();
-    }
+	//~ If same named session exists, it will be destroyed first and created once that completes.
+	if (SessionInterface->GetNamedSession(SessionName) != nullptr)
+	{
+		DestroyBeforeSessionOperation(MoveTemp(Operation));
+		return;
+	}
 
-	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-    CreateSessionCompleteDelegateHandle = SessionInterface->AddOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegate);
-
-	//~ Set session settings.
-	TSharedPtr<FOnlineSessionSettings> SessionSettings = MakeShared<FOnlineSessionSettings>();
-	SessionSettings->bIsDedicated = false;
-	SessionSettings->bIsLANMatch = false;
-	SessionSettings->NumPublicConnections = NumberOfConnections;
-	SessionSettings->NumPrivateConnections = 0;
-	SessionSettings->bUsesPresence = true;
-	SessionSettings->bAllowJoinViaPresence = true;
-	SessionSettings->bAllowJoinViaPresenceFriendsOnly = true;
-	SessionSettings->bAllowInvites = true;
-	SessionSettings->bAllowJoinInProgress = true;
-	SessionSettings->bUseLobbiesIfAvailable = false;
-	SessionSettings->bUseLobbiesVoiceChatIfAvailable = false;
-	SessionSettings->bShouldAdvertise = true;
-	SessionSettings->bUsesStats = true;
-	SessionSettings->BuildUniqueId = 1;
-	SessionSettings->Set(FName("MATCH_TYPE"), MatchType, EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings->Set(FName("SERVER_IS_PRIVATE"), bIsPrivateSession, EOnlineDataAdvertisementType::ViaOnlineService);
+	//~ Store the delegate in a FDelegateHandle while any creation is in flight, so every completion is received.
+	if (GetNumInFlightSessionOperations(EGoSessionOperationType::Create) == 1)
+	{
+		CreateSessionCompleteDelegateHandle = SessionInterface->AddOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegate);
+	}
+
+	//~ Copy the match type's precomputed settings; unregistered match types get the defaults.
+	const FGoMatchType* MatchType = MatchTypeRegistry.Find(Operation.MatchType);
+	const TSharedRef<FOnlineSessionSettings> SessionSettings = MatchType
+		? MakeShared<FOnlineSessionSettings>(*MatchType->SettingsTemplate)
+		: FGoMatchTypeRegistry::MakeSettingsTemplate(Operation.MatchType, Operation.NumberOfConnections);
+	EOSGo::SessionAttributes::IsPrivate.Set(*SessionSettings, Operation.bIsPrivateSession);
+	EOSGo::SessionAttributes::HostSessionName.Set(*SessionSettings, SessionName.ToString());
+	if (ReservationBeaconPort > 0) EOSGo::SessionAttributes::BeaconPort.Set(*SessionSettings, ReservationBeaconPort);
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+	Session.MatchType = Operation.MatchType;
+
+	//~ Presence, presence joins and invites belong to a player; dedicated sessions are reached by search or join code.
+	if (Operation.bIsDedicated)
+	{
+		SessionSettings->bIsDedicated = true;
+		SessionSettings->bUsesPresence = false;
+		SessionSettings->bAllowJoinViaPresence = false;
+		SessionSettings->bAllowJoinViaPresenceFriendsOnly = false;
+		SessionSettings->bAllowInvites = false;
+	}
 
 	//~ Checks if Private Session was toggled and sets a Server Join Id to access to this session.
-    if (bIsPrivateSession)
+	//~ It's never 0, so public searches skip private sessions even when they're only joined by code.
+	const int32 PrivateJoinId = Operation.ServerPrivateJoinId != 0 ? Operation.ServerPrivateJoinId : 1;
+    if (Operation.bIsPrivateSession)
     {
-        ServerJoinId = ServerPrivateJoinId;
-        SessionSettings->Set(FName("SERVER_JOIN_ID"), ServerPrivateJoinId, EOnlineDataAdvertisementType::ViaOnlineService);
+        if (SessionName == NAME_GameSession) ServerJoinId = PrivateJoinId;
+        EOSGo::SessionAttributes::ServerJoinId.Set(*SessionSettings, static_cast<int64>(PrivateJoinId));
     }
     else
     {
-    	SessionSettings->Set(FName("SERVER_JOIN_ID"), 0, EOnlineDataAdvertisementType::ViaOnlineService);
+    	EOSGo::SessionAttributes::ServerJoinId.Set(*SessionSettings, int64(0));
     }
 	
-	//~ CREATE
-    if (!SessionInterface->CreateSession(*User->GetUserId(), NAME_GameSession, *SessionSettings))
+	//~ CREATE - dedicated servers have no logged in user and host as local user 0.
+	Session.State = EGoSessionState::Creating;
+	const FUniqueNetIdPtr LocalUserId = GetLocalUserId();
+	const bool bIsCreating = Operation.bIsDedicated
+		? SessionInterface->CreateSession(0, SessionName, *SessionSettings)
+		: LocalUserId.IsValid() && SessionInterface->CreateSession(*LocalUserId, SessionName, *SessionSettings);
+    if (!bIsCreating)
     {
     	//~ If it doesn't create the session, clear delegate of the delegate list.
-        SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
+        if (GetNumInFlightSessionOperations(EGoSessionOperationType::Create) == 1)
+        {
+        	SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
+        }
+        FGoNamedSession& FailedSession = NamedSessions.FindOrAdd(SessionName);
+        FailedSession.State = EGoSessionState::None;
+        FailedSession.MatchType = NAME_None;
+        if (SessionName == NAME_GameSession) ServerJoinId = 0;
     	//~ Broadcast Go Subsystem Delegate - Creation not successful.
-        GoOnCreateSessionComplete.Broadcast(false);
-        ServerJoinId = 0;
+        BroadcastCreateSessionComplete(SessionName, false);
+        FinishSessionOperation(SessionName, EGoSessionOperationType::Create, false);
     }
 }
 
 
 void UGoSubsystem::OnUpdateSessionComplete(FName SessionName, bool bWasSuccess)
 {
-	//~ If session was updated, clear delegate of the delegate list.
-	if (SessionInterface) SessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+	if (!IsSessionOperationInFlight(SessionName, EGoSessionOperationType::Update)) return;
+
+	//~ If every update has completed, clear delegate of the delegate list.
+	if (SessionInterface && GetNumInFlightSessionOperations(EGoSessionOperationType::Update) <= 1)
+	{
+		SessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+	}
 
 	//~ Broadcast Go Subsystem Delegate - Updating successful.
-	GoOnUpdateSessionComplete.Broadcast(bWasSuccess);
-	LogMessage("Session updated successfully");
+	if (SessionName == NAME_GameSession) GoOnUpdateSessionComplete.Broadcast(bWasSuccess);
+	UE_LOG(LogEOSGoSession, Verbose, TEXT("Session %s updated successfully"), *SessionName.ToString());
+	FinishSessionOperation(SessionName, EGoSessionOperationType::Update, bWasSuccess);
 }
-void UGoSubsystem::UpdateSession(FOnlineSessionSettings& UpdateSessionSettings)
+int32 UGoSubsystem::UpdateSession(const FOnlineSessionSettings& UpdateSessionSettings, FName SessionName, FGoOnRequestComplete OnComplete)
 {
-	if (!SessionInterface.IsValid()) return;
-	
-	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-	UpdateSessionCompleteDelegateHandle = SessionInterface->AddOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegate);
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Update;
+	Operation.SessionName = SessionName;
+	Operation.UpdateSettings = MakeShared<FOnlineSessionSettings>(UpdateSessionSettings);
+	return RequestSessionOperation(MoveTemp(Operation), MoveTemp(OnComplete));
+}
+void UGoSubsystem::ExecuteUpdateSession(FGoSessionOperation&& Operation)
+{
+	//~ Updates are built from settings copied at any time; the beacon port must survive all of them, and a closed beacon (0)
+	//~ must replace the port copied from before it closed.
+	int32 CopiedBeaconPort = 0;
+	if (ReservationBeaconPort > 0 || EOSGo::SessionAttributes::BeaconPort.Get(*Operation.UpdateSettings, CopiedBeaconPort))
+	{
+		EOSGo::SessionAttributes::BeaconPort.Set(*Operation.UpdateSettings, ReservationBeaconPort);
+	}
+
+
+	//~ Store the delegate in a FDelegateHandle while any update is in flight, so every completion is received.
+	if (GetNumInFlightSessionOperations(EGoSessionOperationType::Update) == 1)
+	{
+		UpdateSessionCompleteDelegateHandle = SessionInterface->AddOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegate);
+	}
 	
 	//~ UPDATE
-	if (!SessionInterface->UpdateSession(NAME_GameSession, UpdateSessionSettings))
+	if (!SessionInterface->UpdateSession(Operation.SessionName, *Operation.UpdateSettings))
 	{
-		LogMessage("Updating Failed");
+		UE_LOG(LogEOSGoSession, Warning, TEXT("UpdateSession could not be started"));
 		//~ If Updating wasn't successful, clear delegate of the delegate list.
-		SessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+		if (GetNumInFlightSessionOperations(EGoSessionOperationType::Update) == 1)
+		{
+			SessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+		}
 		//~ Broadcast Go Subsystem Delegate - Updating wasn't successful.
-		GoOnUpdateSessionComplete.Broadcast(false);
+		if (Operation.SessionName == NAME_GameSession) GoOnUpdateSessionComplete.Broadcast(false);
+		FinishSessionOperation(Operation.SessionName, EGoSessionOperationType::Update, false);
 	}
 }
 
 
 void UGoSubsystem::OnFindSessionsComplete(bool bWasSuccess)
 {
+	//~ A cancelled search may still report its completion; the search in flight hasn't completed yet.
+	if (SessionSearchSettings.IsValid() && SessionSearchSettings->SearchState == EOnlineAsyncTaskState::InProgress) return;
+
 	//~ If searching was successful, clear delegate of the delegate list.
 	if (SessionInterface) SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
 
-	//~ Use a timer to delay broadcasting the results.
-	FTimerHandle TimerHandle;
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
+	TSharedPtr<FOnlineSessionSearch> CompletedSearch = SessionSearchSettings;
+	bWasSuccess = bWasSuccess && CompletedSearch.IsValid() && CompletedSearch->SearchState == EOnlineAsyncTaskState::Done;
+	if (bWasSuccess && InFlightSearchQuery.IsSet() && FindSessionsCacheTimeToLive > 0.f)
+	{
+		SessionSearchCache.Add(InFlightSearchQuery.GetValue(), CompletedSearch.ToSharedRef());
+	}
+	//~ Streaming requests get the last batch first: their joins don't wait for the display time below.
+	bool bIsStreamingOnly = false;
+	if (InFlightSearchQuery.IsSet())
+	{
+		const TArray<FOnlineSessionSearchResult> NoResults;
+		bIsStreamingOnly = HasStreamingSearchRequests(InFlightSearchQuery.GetValue());
+		FinishStreamingSearches(InFlightSearchQuery.GetValue(), bWasSuccess ? CompletedSearch->SearchResults : NoResults);
+	}
+	TArray<FGoFindSessionsRequest> Requests = InFlightSearchQuery.IsSet() ? TakeFindSessionsRequests(InFlightSearchQuery.GetValue()) : TArray<FGoFindSessionsRequest>();
+	bIsStreamingOnly = bIsStreamingOnly && Requests.IsEmpty();
+	InFlightSearchQuery.Reset();
+	FGoOperationMetrics::Get().End(EGoOnlineOperation::Find, bWasSuccess, bWasSuccess ? CompletedSearch->SearchResults.Num() : 0);
+
+	//~ Results are ready now; only hold them back if the UI asked for a minimum display time.
+	const float Elapsed = static_cast<float>(FPlatformTime::Seconds() - FindSessionsStartTime);
+	LastFindSessionsTimeToResults = FMath::Max(Elapsed, MinFindSessionsDisplayTime);
+	UE_LOG(LogEOSGoSearch, Verbose, TEXT("FindSessions time-to-results: %.3fs"), LastFindSessionsTimeToResults);
+
+	//~ A search only streaming requests waited on was answered through those requests alone.
+	if (!bIsStreamingOnly)
 	{
-		if (SessionSearchSettings->SearchState == EOnlineAsyncTaskState::Done)
+		if (Elapsed < MinFindSessionsDisplayTime)
 		{
-			//~ Broadcast Go Subsystem Delegate - Searching successful.
-			GoOnFindSessionsComplete.Broadcast(SessionSearchSettings->SearchResults, true); 
-			LogMessage("EOnlineAsyncTaskState::Done");
-			return;
+			DeferFindSessionsResults({CompletedSearch, bWasSuccess, FindSessionsStartTime + MinFindSessionsDisplayTime, MoveTemp(Requests)});
 		}
-		if (SessionSearchSettings->SearchState == EOnlineAsyncTaskState::Failed)
+		else
 		{
-			//~ Broadcast Go Subsystem Delegate - Searching wasn't successful.
-			GoOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(),false);
-			LogMessage("EOnlineAsyncTaskState::Failed");
-			return;
+			BroadcastFindSessionsResults(CompletedSearch, bWasSuccess, MoveTemp(Requests));
 		}
+	}
 
-		//~ Search is In Progress or Not Started
-		LogMessage("Search is In Progress or Not Started");
-	}, 3.0f, false);
+	//~ Run searches that were queued behind this one.
+	StartNextPendingFindSessions();
 }
-void UGoSubsystem::GoFindSessions(int64 InServerJoinId)
+void UGoSubsystem::BroadcastFindSessionsResults(TSharedPtr<FOnlineSessionSearch> Search, bool bWasSuccess, TArray<FGoFindSessionsRequest> Requests)
 {
-	if (!SessionInterface.IsValid()) return;
-
-	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-	FindSessionsCompleteDelegateHandle = SessionInterface->AddOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegate);
-
-	//~ Filter by
-	SessionSearchSettings = MakeShareable(new FOnlineSessionSearch());
-	SessionSearchSettings->QuerySettings.SearchParams.Empty();
-	SessionSearchSettings->MaxSearchResults = 100;
-	SessionSearchSettings->bIsLanQuery = false;
-	//~ Add the attribute in order to join private sessions.
-	SessionSearchSettings->QuerySettings.SearchParams.Add(
-		FName("SERVER_JOIN_ID"), FOnlineSessionSearchParam(InServerJoinId, EOnlineComparisonOp::Equals)
-	);
+	if (bWasSuccess && Search.IsValid())
+	{
+		//~ Broadcast Go Subsystem Delegate - Searching successful.
+		GoOnFindSessionsComplete.Broadcast(Search->SearchResults, true);
+		CompleteGoRequests(Requests, true, NAME_None, Search->SearchResults.Num(), Search->SearchResults);
+		return;
+	}
 	
-	//~ SEARCH
-	if (!SessionInterface->FindSessions(*User->GetUserId(), SessionSearchSettings.ToSharedRef()))
+	//~ Broadcast Go Subsystem Delegate - Searching wasn't successful.
+	UE_LOG(LogEOSGoSearch, Warning, TEXT("Searching for sessions failed"));
+	GoOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), false);
+	CompleteGoRequests(Requests, false, NAME_None, 0, TArray<FOnlineSessionSearchResult>());
+}
+void UGoSubsystem::DeferFindSessionsResults(FGoDeferredFindSessionsResults&& Deferred)
+{
+	DeferredFindSessionsResults.Add(MoveTemp(Deferred));
+	if (!DeferredFindSessionsTickerHandle.IsValid())
 	{
-		LogMessage("Searching for sessions failed");
-		//~ If searching wasn't successful, clear delegate of the delegate list.
-		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-		//~ Broadcast Go Subsystem Delegate - Searching wasn't successful.
-		GoOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(),false);
+		DeferredFindSessionsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickDeferredFindSessionsResults));
 	}
 }
-
-
-void UGoSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+bool UGoSubsystem::TickDeferredFindSessionsResults(float DeltaTime)
 {
-	//~ If joining was successful, clear delegate of the delegate list.
-	if (SessionInterface) SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
-	
-	//~ Broadcast Go Subsystem Delegate - Joining was successful.
-	if (Result == EOnJoinSessionCompleteResult::Success)
+	//~ Taken first: callbacks may defer (or cancel) more results.
+	const double Now = FPlatformTime::Seconds();
+	TArray<FGoDeferredFindSessionsResults> Ready;
+	for (int32 Index = 0; Index < DeferredFindSessionsResults.Num();)
+	{
+		if (DeferredFindSessionsResults[Index].DeliveryTime > Now)
+		{
+			++Index;
+			continue;
+		}
+		Ready.Add(MoveTemp(DeferredFindSessionsResults[Index]));
+		DeferredFindSessionsResults.RemoveAt(Index);
+	}
+
+	for (FGoDeferredFindSessionsResults& Deferred : Ready)
 	{
-		GoOnJoinSessionComplete.Broadcast(SessionName, Result);
+		if (Deferred.StreamingQuery.IsSet()) FinishStreamingSearches(Deferred.StreamingQuery.GetValue(), Deferred.Search->SearchResults);
+		else BroadcastFindSessionsResults(Deferred.Search, Deferred.bWasSuccessful, MoveTemp(Deferred.Requests));
 	}
+
+	if (!DeferredFindSessionsResults.IsEmpty()) return true;
+	DeferredFindSessionsTickerHandle.Reset();
+	return false;
 }
-void UGoSubsystem::GoJoinSession(const FOnlineSessionSearchResult& SessionSearchResult)
+int32 UGoSubsystem::GoFindSessions(int64 InServerJoinId, FName MatchType, FGoOnFindSessionsRequestComplete OnComplete)
+{
+	FGoFindSessionsRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+
+	FGoSessionSearchQuery Query;
+	Query.ServerJoinId = InServerJoinId;
+	Query.MatchType = MatchType;
+	FindSessions(Query, MoveTemp(Request));
+	return RequestId;
+}
+void UGoSubsystem::FindSessions(const FGoSessionSearchQuery& Query, FGoFindSessionsRequest&& Request)
 {
 	if (!SessionInterface.IsValid())
-	{	
-		GoOnJoinSessionComplete.Broadcast(FName(), EOnJoinSessionCompleteResult::UnknownError);
+	{
+		Request.Complete(false, NAME_None, 0, TArray<FOnlineSessionSearchResult>());
 		return;
 	}
-	
-	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-	JoinSessionCompleteDelegateHandle = SessionInterface->AddOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegate);
 
-	//~ JOIN
-	if (!SessionInterface->JoinSession(*User->GetUserId(), NAME_GameSession, SessionSearchResult))
+	//~ Serve fresh cached results without a backend query.
+	if (const TSharedPtr<FOnlineSessionSearch> CachedSearch = SessionSearchCache.Find(Query, FindSessionsCacheTimeToLive))
 	{
-		LogMessage("Joining Failed");
-		//~ If joining wasn't successful, clear delegate of the delegate list.
-		SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
-		//~ Broadcast Go Subsystem Delegate - Joining wasn't successful.
-		GoOnJoinSessionComplete.Broadcast(FName(), EOnJoinSessionCompleteResult::UnknownError);
+		LastFindSessionsTimeToResults = 0.f;
+		DeferFindSessionsResults({CachedSearch, true, FPlatformTime::Seconds(), {MoveTemp(Request)}});
+		return;
 	}
-}
-
 
-void UGoSubsystem::OnDestroySessionComplete(FName SessionName, bool bWasSuccess)
-{
-	//~ If destroying was successful, clear delegate of the delegate list.
-	if (SessionInterface) SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-	
-	//~ Broadcast Go Subsystem Delegate - Destroying was successful.
-	if (bWasSuccess && bCreateSessionOnDestroy)
+	//~ Callers with the same query share the in-flight search; other queries wait for it to complete.
+	PendingFindSessionsRequests.Add({Query, MoveTemp(Request)});
+	if (InFlightSearchQuery.IsSet())
 	{
-		bCreateSessionOnDestroy = false;
-		GoOnDestroySessionComplete.Broadcast(bWasSuccess);
-		GoCreateSession(LastNumberOfPublicConnections, LastMatchType, LastServerPrivateJoinId, bCreatePrivateSession);
+		if (InFlightSearchQuery.GetValue() != Query) PendingSearchQueries.AddUnique(Query);
 		return;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("Destroying session: %s "), *SessionName.ToString());
-	GoOnDestroySessionComplete.Broadcast(bWasSuccess);
+	if (!StartFindSessions(Query))
+	{
+		//~ Broadcast Go Subsystem Delegate - Searching wasn't successful.
+		FailFindSessions(Query);
+	}
 }
-void UGoSubsystem::GoDestroySession()
+int32 UGoSubsystem::GoFindAndJoinSession(int64 InServerJoinId, FName MatchType, FGoSessionSearchPredicate JoinPredicate, FGoOnFindSessionsBatch OnBatch,
+	FGoOnRequestComplete OnComplete)
 {
+	FGoStreamingSearchRequest Streaming;
+	Streaming.Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Streaming.Request.RequestId;
 	if (!SessionInterface.IsValid())
-	{	
-		GoOnDestroySessionComplete.Broadcast(false);
-		return;
+	{
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::UnknownError);
+		Streaming.Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::UnknownError);
+		return RequestId;
 	}
 
-	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-	DestroySessionCompleteDelegateHandle = SessionInterface->AddOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegate);
-	
-	//~ DESTROY
-	if (!SessionInterface->DestroySession(NAME_GameSession))
+	Streaming.Query.ServerJoinId = InServerJoinId;
+	Streaming.Query.MatchType = MatchType;
+	Streaming.JoinPredicate = JoinPredicate ? MoveTemp(JoinPredicate) : MakeJoinPredicate(MatchType);
+	Streaming.OnBatch = MoveTemp(OnBatch);
+	const FGoSessionSearchQuery Query = Streaming.Query;
+	StreamingSearchRequests.Add(MoveTemp(Streaming));
+
+	//~ Fresh cached results are a single, final batch.
+	if (const TSharedPtr<FOnlineSessionSearch> CachedSearch = SessionSearchCache.Find(Query, FindSessionsCacheTimeToLive))
 	{
-		LogMessage("Destroy session Failed");
-		//~ If destroying wasn't successful, clear delegate of the delegate list.
-		SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-		//~ Broadcast Go Subsystem Delegate - Destroying wasn't successful.
-		GoOnDestroySessionComplete.Broadcast(false);
+		LastFindSessionsTimeToResults = 0.f;
+		DeferFindSessionsResults({CachedSearch, true, FPlatformTime::Seconds(), {}, Query});
+		return RequestId;
 	}
-}
 
+	//~ Joining the in-flight search streams the results it already has on the next poll; other queries wait for it to complete.
+	if (InFlightSearchQuery.IsSet())
+	{
+		if (InFlightSearchQuery.GetValue() != Query) PendingSearchQueries.AddUnique(Query);
+		UpdateSearchStreaming();
+		return RequestId;
+	}
 
-void UGoSubsystem::OnStartSessionComplete(FName SessionName, bool bWasSuccess)
+	if (!StartFindSessions(Query)) FailFindSessions(Query);
+	return RequestId;
+}
+FGoSessionSearchPredicate UGoSubsystem::MakeJoinPredicate(FName MatchType, int32 MinOpenSlots)
 {
-	//~ If starting wasn't successful, clear delegate of the delegate list.
-	SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
+	const FString MatchTypeString = MatchType.IsNone() ? FString() : MatchType.ToString();
+	return [MatchTypeString, MinOpenSlots = FMath::Max(MinOpenSlots, 1)](const FOnlineSessionSearchResult& SearchResult)
+	{
+		if (SearchResult.Session.NumOpenPublicConnections < MinOpenSlots) return false;
+		if (MatchTypeString.IsEmpty()) return true;
 
-	//~ Broadcast Go Subsystem Delegate - Starting was successful.
-	UE_LOG(LogTemp, Warning, TEXT("Starting session: %s "), *SessionName.ToString());
-	GoOnStartSessionComplete.Broadcast(bWasSuccess);
+		FString SessionMatchType;
+		return EOSGo::SessionAttributes::MatchType.Get(SearchResult.Session.SessionSettings, SessionMatchType) && SessionMatchType == MatchTypeString;
+	};
 }
-void UGoSubsystem::GoStartSession()
+TArray<FGoFindSessionsRequest> UGoSubsystem::TakeFindSessionsRequests(const FGoSessionSearchQuery& Query)
 {
-	if (!SessionInterface.IsValid())
-	{	
-		GoOnStartSessionComplete.Broadcast(false);
-		return;
+	TArray<FGoFindSessionsRequest> Requests;
+	for (const FGoPendingFindSessionsRequest& Pending : PendingFindSessionsRequests)
+	{
+		if (Pending.Query == Query) Requests.Add(Pending.Request);
 	}
+	PendingFindSessionsRequests.RemoveAll([&Query](const FGoPendingFindSessionsRequest& Pending) { return Pending.Query == Query; });
+	return Requests;
+}
+bool UGoSubsystem::StartFindSessions(const FGoSessionSearchQuery& Query)
+{
+	FindSessionsStartTime = FPlatformTime::Seconds();
+	FGoOperationMetrics::Get().Begin(EGoOnlineOperation::Find);
 
 	//~ Store the delegate in a FDelegateHandle, so we can later remove it from the delegate list.
-	StartSessionCompleteDelegateHandle = SessionInterface->AddOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegate);
+	FindSessionsCompleteDelegateHandle = SessionInterface->AddOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegate);
+
+	//~ Filter by
+	SessionSearchSettings = MakeShareable(new FOnlineSessionSearch());
+	SessionSearchSettings->QuerySettings.SearchParams.Empty();
+	SessionSearchSettings->MaxSearchResults = 100;
+	SessionSearchSettings->bIsLanQuery = false;
+	//~ Add the attribute in order to join private sessions.
+	EOSGo::SessionAttributes::ServerJoinId.SetSearchParam(*SessionSearchSettings, Query.ServerJoinId);
+	//~ Add the match type when searching for a specific one.
+	if (!Query.MatchType.IsNone())
+	{
+		EOSGo::SessionAttributes::MatchType.SetSearchParam(*SessionSearchSettings, Query.MatchType.ToString());
+	}
 	
-	//~ START
-	if (!SessionInterface->StartSession(NAME_GameSession))
+	//~ SEARCH
+	InFlightSearchQuery = Query;
+	const FUniqueNetIdPtr LocalUserId = GetLocalUserId();
+	if (!LocalUserId.IsValid() || !SessionInterface->FindSessions(*LocalUserId, SessionSearchSettings.ToSharedRef()))
 	{
-		LogMessage("Start session Failed");
-		//~ If starting wasn't successful, clear delegate of the delegate list.
-		SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
-		//~ Broadcast Go Subsystem Delegate - Starting wasn't successful.
-		GoOnStartSessionComplete.Broadcast(false);
-	}	
+		UE_LOG(LogEOSGoSearch, Warning, TEXT("FindSessions could not be started"));
+		//~ If searching wasn't successful, clear delegate of the delegate list.
+		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+		InFlightSearchQuery.Reset();
+		FGoOperationMetrics::Get().End(EGoOnlineOperation::Find, false);
+		return false;
+	}
+	UpdateSearchStreaming();
+	return true;
+}
+void UGoSubsystem::StartNextPendingFindSessions()
+{
+	while (!InFlightSearchQuery.IsSet() && PendingSearchQueries.Num() > 0 && SessionInterface.IsValid())
+	{
+		const FGoSessionSearchQuery Query = PendingSearchQueries[0];
+		PendingSearchQueries.RemoveAt(0);
+		if (!StartFindSessions(Query))
+		{
+			FailFindSessions(Query);
+		}
+	}
+}
+void UGoSubsystem::FailFindSessions(const FGoSessionSearchQuery& Query)
+{
+	TArray<FGoFindSessionsRequest> Requests = TakeFindSessionsRequests(Query);
+	if (!Requests.IsEmpty() || !HasStreamingSearchRequests(Query))
+	{
+		BroadcastFindSessionsResults(nullptr, false, MoveTemp(Requests));
+	}
+	FinishStreamingSearches(Query, TArray<FOnlineSessionSearchResult>());
+}
+void UGoSubsystem::StreamSearchResults(const FGoSessionSearchQuery& Query, const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	//~ Looked up by id for each batch: callbacks may issue or cancel requests.
+	TArray<int32> RequestIds;
+	for (const FGoStreamingSearchRequest& Streaming : StreamingSearchRequests)
+	{
+		if (Streaming.Query == Query && Streaming.NumDelivered < SessionResults.Num()) RequestIds.Add(Streaming.Request.RequestId);
+	}
+
+	for (const int32 RequestId : RequestIds)
+	{
+		FGoStreamingSearchRequest* Streaming = StreamingSearchRequests.FindByPredicate([RequestId](const FGoStreamingSearchRequest& Pending) { return Pending.Request.RequestId == RequestId; });
+		if (!Streaming || Streaming->NumDelivered >= SessionResults.Num()) continue;
+
+		const TArray<FOnlineSessionSearchResult> Batch(SessionResults.GetData() + Streaming->NumDelivered, SessionResults.Num() - Streaming->NumDelivered);
+		Streaming->NumDelivered = SessionResults.Num();
+		TArray<FOnlineSessionSearchResult> Accepted = Batch.FilterByPredicate(Streaming->JoinPredicate);
+		RankJoinCandidates(Accepted, Query.MatchType);
+
+		const FGoOnFindSessionsBatch OnBatch = Streaming->OnBatch;
+		OnBatch.ExecuteIfBound(Batch);
+
+		//~ The request may have been cancelled from its batch callback.
+		FGoStreamingSearchRequest Joining;
+		if (Accepted.IsEmpty() || !TakeStreamingSearchRequest(RequestId, Joining)) continue;
+
+		UE_LOG(LogEOSGoSearch, Log, TEXT("Streaming search accepted %d of the %d result(s) so far, joining the best"), Accepted.Num(), Joining.NumDelivered);
+		JoinRankedCandidates(MoveTemp(Accepted), MoveTemp(Joining.Request));
+	}
+}
+void UGoSubsystem::FinishStreamingSearches(const FGoSessionSearchQuery& Query, const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	//~ Requests issued from a batch callback get the results too.
+	auto HasUndelivered = [&Query, &SessionResults](const FGoStreamingSearchRequest& Streaming)
+	{
+		return Streaming.Query == Query && Streaming.NumDelivered < SessionResults.Num();
+	};
+	while (StreamingSearchRequests.ContainsByPredicate(HasUndelivered))
+	{
+		StreamSearchResults(Query, SessionResults);
+	}
+
+	TArray<FGoRequest> Unmatched;
+	for (const FGoStreamingSearchRequest& Streaming : StreamingSearchRequests)
+	{
+		if (Streaming.Query == Query) Unmatched.Add(Streaming.Request);
+	}
+	StreamingSearchRequests.RemoveAll([&Query](const FGoStreamingSearchRequest& Streaming) { return Streaming.Query == Query; });
+	UpdateSearchStreaming();
+
+	for (const FGoRequest& Request : Unmatched)
+	{
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+	}
+}
+bool UGoSubsystem::TakeStreamingSearchRequest(int32 RequestId, FGoStreamingSearchRequest& OutRequest)
+{
+	const int32 Index = StreamingSearchRequests.IndexOfByPredicate([RequestId](const FGoStreamingSearchRequest& Streaming) { return Streaming.Request.RequestId == RequestId; });
+	if (Index == INDEX_NONE) return false;
+
+	OutRequest = MoveTemp(StreamingSearchRequests[Index]);
+	StreamingSearchRequests.RemoveAt(Index);
+	return true;
+}
+bool UGoSubsystem::HasStreamingSearchRequests(const FGoSessionSearchQuery& Query) const
+{
+	return StreamingSearchRequests.ContainsByPredicate([&Query](const FGoStreamingSearchRequest& Streaming) { return Streaming.Query == Query; });
+}
+void UGoSubsystem::UpdateSearchStreaming()
+{
+	const bool bShouldPoll = InFlightSearchQuery.IsSet() && HasStreamingSearchRequests(InFlightSearchQuery.GetValue());
+	if (bShouldPoll && !SearchStreamingTickerHandle.IsValid())
+	{
+		SearchStreamingTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickSearchStreaming));
+	}
+	else if (!bShouldPoll && SearchStreamingTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SearchStreamingTickerHandle);
+		SearchStreamingTickerHandle.Reset();
+	}
+}
+bool UGoSubsystem::TickSearchStreaming(float DeltaTime)
+{
+	//~ Backends that stream fill SearchResults while the search is in progress; the others only on completion.
+	//~ Held: a join started from a batch may start another search.
+	const TSharedPtr<FOnlineSessionSearch> Search = SessionSearchSettings;
+	if (InFlightSearchQuery.IsSet() && Search.IsValid() && Search->SearchState == EOnlineAsyncTaskState::InProgress)
+	{
+		StreamSearchResults(InFlightSearchQuery.GetValue(), Search->SearchResults);
+		CancelFindSessionsIfUnwanted();
+	}
+
+	if (InFlightSearchQuery.IsSet() && HasStreamingSearchRequests(InFlightSearchQuery.GetValue())) return true;
+	SearchStreamingTickerHandle.Reset();
+	return false;
+}
+void UGoSubsystem::CancelFindSessionsIfUnwanted()
+{
+	if (!InFlightSearchQuery.IsSet() || !SessionInterface.IsValid() || !SessionSearchSettings.IsValid()) return;
+	if (SessionSearchSettings->SearchState != EOnlineAsyncTaskState::InProgress) return;
+
+	const FGoSessionSearchQuery Query = InFlightSearchQuery.GetValue();
+	if (HasStreamingSearchRequests(Query)) return;
+	if (PendingFindSessionsRequests.ContainsByPredicate([&Query](const FGoPendingFindSessionsRequest& Pending) { return Pending.Query == Query; })) return;
+
+	//~ Backends report a cancelled search through OnCancelFindSessionsComplete at most: it's finished here, and never cached.
+	UE_LOG(LogEOSGoSearch, Log, TEXT("Cancelling search after %d results, nobody waits for the rest"), SessionSearchSettings->SearchResults.Num());
+	SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+	SessionInterface->CancelFindSessions();
+	InFlightSearchQuery.Reset();
+	//~ Timed up to the accepted result, which is what its caller waited for.
+	FGoOperationMetrics::Get().End(EGoOnlineOperation::Find, true, SessionSearchSettings->SearchResults.Num());
+	LastFindSessionsTimeToResults = static_cast<float>(FPlatformTime::Seconds() - FindSessionsStartTime);
+
+	StartNextPendingFindSessions();
+	UpdateSearchStreaming();
+}
+void UGoSubsystem::InvalidateSessionSearchCache()
+{
+	SessionSearchCache.Invalidate();
+}
+
+
+void UGoSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (!IsSessionOperationInFlight(SessionName, EGoSessionOperationType::Join)) return;
+
+	//~ If every join has completed, clear delegate of the delegate list.
+	if (SessionInterface && GetNumInFlightSessionOperations(EGoSessionOperationType::Join) <= 1)
+	{
+		SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+	}
+	
+	//~ A full or vanished session means cached search results are stale.
+	if (Result != EOnJoinSessionCompleteResult::Success) SessionSearchCache.Invalidate();
+
+	//~ A failed join may still leave a named session behind (e.g. AlreadyInSession).
+	NamedSessions.FindOrAdd(SessionName).State = Result == EOnJoinSessionCompleteResult::Success || (SessionInterface && SessionInterface->GetNamedSession(SessionName))
+		? EGoSessionState::Pending : EGoSessionState::None;
+
+	//~ Fail over to the join's next-best candidate without a new search.
+	const bool bCanFailOver = Result != EOnJoinSessionCompleteResult::Success && Result != EOnJoinSessionCompleteResult::AlreadyInSession;
+	FGoInFlightSessionOperation* InFlight = InFlightSessionOperations.FindByKey(FGoInFlightSessionOperation{SessionName, EGoSessionOperationType::Join});
+	if (bCanFailOver && InFlight && InFlight->FailoverCandidates.Num() > 0)
+	{
+		UE_LOG(LogEOSGoSession, Log, TEXT("Joining failed, trying next candidate (%d left)"), InFlight->FailoverCandidates.Num());
+		TArray<TSharedPtr<FOnlineSessionSearchResult>> Candidates = MoveTemp(InFlight->FailoverCandidates);
+		TArray<FGoRequest> Requests = MoveTemp(InFlight->Requests);
+		EnqueueJoinSession(MoveTemp(Candidates), MoveTemp(Requests));
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Join, false, Result);
+		return;
+	}
+
+	//~ Broadcast Go Subsystem Delegate - Joining result.
+	BroadcastJoinSessionComplete(SessionName, Result);
+	FinishSessionOperation(SessionName, EGoSessionOperationType::Join, Result == EOnJoinSessionCompleteResult::Success, Result);
+}
+int32 UGoSubsystem::GoJoinSession(const FOnlineSessionSearchResult& SessionSearchResult, FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	JoinSession(SessionSearchResult, MoveTemp(Request));
+	return RequestId;
+}
+void UGoSubsystem::JoinSession(const FOnlineSessionSearchResult& SessionSearchResult, FGoRequest&& Request)
+{
+	if (!SessionInterface.IsValid())
+	{	
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::UnknownError);
+		Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::UnknownError);
+		return;
+	}
+
+	EnqueueJoinSession({MakeShared<FOnlineSessionSearchResult>(SessionSearchResult)}, {MoveTemp(Request)});
+}
+int32 UGoSubsystem::GoJoinBestSession(const TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType, FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	TArray<FOnlineSessionSearchResult> Candidates = SessionResults;
+	RankJoinCandidates(Candidates, PreferredMatchType);
+	JoinRankedCandidates(MoveTemp(Candidates), MoveTemp(Request));
+	return RequestId;
+}
+void UGoSubsystem::JoinRankedCandidates(TArray<FOnlineSessionSearchResult>&& Candidates, FGoRequest&& Request)
+{
+	if (!SessionInterface.IsValid() || Candidates.IsEmpty())
+	{
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		return;
+	}
+
+	//~ Keep the runners-up for failover; the request follows the join from candidate to candidate.
+	const int32 NumAttempts = FMath::Min(Candidates.Num(), FMath::Max(MaxJoinAttempts, 1));
+	TArray<TSharedPtr<FOnlineSessionSearchResult>> Attempts;
+	Attempts.Reserve(NumAttempts);
+	for (int32 Index = 0; Index < NumAttempts; ++Index)
+	{
+		Attempts.Add(MakeShared<FOnlineSessionSearchResult>(MoveTemp(Candidates[Index])));
+	}
+	EnqueueJoinSession(MoveTemp(Attempts), {MoveTemp(Request)});
+}
+int32 UGoSubsystem::GoJoinSessionByCode(const FString& JoinCode)
+{
+	return GoJoinSessionByCode(JoinCode, FGoOnRequestComplete());
+}
+int32 UGoSubsystem::GoJoinSessionByCode(const FString& JoinCode, FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+
+	FString SessionIdString;
+	const FUniqueNetIdPtr LocalUserId = GetLocalUserId();
+	const FUniqueNetIdPtr SessionId = SessionInterface.IsValid() && FGoJoinCode::Decode(JoinCode, SessionIdString)
+		? SessionInterface->CreateSessionIdFromString(SessionIdString) : nullptr;
+	if (!SessionId.IsValid() || !LocalUserId.IsValid())
+	{
+		UE_LOG(LogEOSGoSearch, Warning, TEXT("Join code %s can't be looked up"), *JoinCode);
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		return RequestId;
+	}
+
+	//~ LOOKUP - keyed by request, so lookups run side by side. Some backends complete synchronously, even when returning false.
+	FindSessionByIdLookups.Add(RequestId);
+	FindSessionByIdRequests.Add(MoveTemp(Request));
+	FGoOperationMetrics::Get().Begin(EGoOnlineOperation::Find, 0, FName(TEXT("GoJoinCode"), RequestId));
+	if (!SessionInterface->FindSessionById(*LocalUserId, *SessionId, *LocalUserId,
+		FOnSingleSessionResultCompleteDelegate::CreateUObject(this, &ThisClass::OnFindSessionByIdComplete, RequestId)) && FindSessionByIdLookups.Contains(RequestId))
+	{
+		OnFindSessionByIdComplete(GetLocalUserNum(), false, FOnlineSessionSearchResult(), RequestId);
+	}
+	return RequestId;
+}
+void UGoSubsystem::OnFindSessionByIdComplete(int32 LocalUserNum, bool bWasSuccess, const FOnlineSessionSearchResult& SearchResult, int32 RequestId)
+{
+	if (FindSessionByIdLookups.RemoveSingle(RequestId) == 0) return;
+
+	bWasSuccess = bWasSuccess && SearchResult.IsValid();
+	FGoOperationMetrics::Get().End(EGoOnlineOperation::Find, bWasSuccess, bWasSuccess ? 1 : 0, FName(TEXT("GoJoinCode"), RequestId));
+
+	//~ Cancelled while looking the session up: nobody is waiting to join it.
+	FGoRequest Request;
+	if (!TakeGoRequest(FindSessionByIdRequests, RequestId, Request)) return;
+	if (!bWasSuccess)
+	{
+		UE_LOG(LogEOSGoSearch, Warning, TEXT("No session found for the join code"));
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		Request.Complete(false, NAME_None, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		return;
+	}
+	JoinSession(SearchResult, MoveTemp(Request));
+}
+FString UGoSubsystem::GetNamedSessionJoinCode(FName SessionName) const
+{
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(SessionName) : nullptr;
+	return Session && Session->SessionInfo.IsValid() ? FGoJoinCode::Encode(Session->SessionInfo->GetSessionId().ToString()) : FString();
+}
+bool UGoSubsystem::GetJoinedSessionTravelUrl(FString& OutUrl) const
+{
+	if (!SessionInterface.IsValid() || !SessionInterface->GetResolvedConnectString(NAME_GameSession, OutUrl) || OutUrl.IsEmpty()) return false;
+
+	//~ Servers hosting several sessions route arriving players to theirs by name (AGoGameModeBase::InitNewPlayer).
+	FString HostSessionName;
+	const FOnlineSessionSettings* Settings = SessionInterface->GetSessionSettings(NAME_GameSession);
+	if (Settings && EOSGo::SessionAttributes::HostSessionName.Get(*Settings, HostSessionName) && FName(HostSessionName) != NAME_GameSession)
+	{
+		OutUrl += FString::Printf(TEXT("?GoSession=%s"), *HostSessionName);
+	}
+	if (const FGoNamedSession* Session = NamedSessions.Find(NAME_GameSession); Session && !Session->ReservationToken.IsEmpty())
+	{
+		OutUrl += FString::Printf(TEXT("?GoReservation=%s"), *Session->ReservationToken);
+	}
+	return true;
+}
+void UGoSubsystem::RankJoinCandidates(TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType)
+{
+	//~ Full sessions would only fail after a join round trip.
+	SessionResults.RemoveAll([](const FOnlineSessionSearchResult& Result)
+	{
+		return !Result.IsValid() || Result.Session.NumOpenPublicConnections <= 0;
+	});
+
+	const FString PreferredMatchTypeString = PreferredMatchType.IsNone() ? FString() : PreferredMatchType.ToString();
+	auto Score = [&PreferredMatchTypeString](const FOnlineSessionSearchResult& Result)
+	{
+		float Value = 0.f;
+		//~ The requested match type outranks everything else.
+		if (!PreferredMatchTypeString.IsEmpty())
+		{
+			FString MatchType;
+			EOSGo::SessionAttributes::MatchType.Get(Result.Session.SessionSettings, MatchType);
+			if (MatchType == PreferredMatchTypeString) Value += 10000.f;
+		}
+		//~ Lower ping is better; unknown pings are reported as very large values.
+		Value -= static_cast<float>(FMath::Clamp(Result.PingInMs, 0, 1000));
+		//~ Among similar pings, prefer lobbies closer to full so they start sooner, but keep one open slot of margin.
+		const int32 OpenSlots = Result.Session.NumOpenPublicConnections;
+		Value += OpenSlots > 1 ? 50.f / OpenSlots : 25.f;
+		return Value;
+	};
+
+	TArray<TPair<float, int32>> Scores;
+	Scores.Reserve(SessionResults.Num());
+	for (int32 Index = 0; Index < SessionResults.Num(); ++Index)
+	{
+		Scores.Emplace(Score(SessionResults[Index]), Index);
+	}
+	Scores.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+
+	TArray<FOnlineSessionSearchResult> Ranked;
+	Ranked.Reserve(Scores.Num());
+	for (const TPair<float, int32>& Scored : Scores)
+	{
+		Ranked.Add(MoveTemp(SessionResults[Scored.Value]));
+	}
+	SessionResults = MoveTemp(Ranked);
+}
+void UGoSubsystem::EnqueueJoinSession(TArray<TSharedPtr<FOnlineSessionSearchResult>>&& Candidates, TArray<FGoRequest>&& Requests)
+{
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Join;
+	Operation.SearchResult = Candidates[0];
+	Candidates.RemoveAt(0);
+	Operation.FailoverCandidates = MoveTemp(Candidates);
+	Operation.Requests = MoveTemp(Requests);
+	EnqueueSessionOperation(MoveTemp(Operation));
+}
+void UGoSubsystem::BroadcastJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	GoOnJoinSessionComplete.Broadcast(SessionName, Result);
+}
+void UGoSubsystem::ExecuteJoinSession(FGoSessionOperation&& Operation)
+{
+	const FName SessionName = Operation.SessionName;
+
+	//~ If same named session exists, it will be destroyed first and joined once that completes.
+	if (SessionInterface->GetNamedSession(SessionName) != nullptr)
+	{
+		DestroyBeforeSessionOperation(MoveTemp(Operation));
+		return;
+	}
+
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+	Session.State = EGoSessionState::Joining;
+	Session.ReservationToken.Reset();
+
+	//~ Ask the host for a slot first; the backend join starts once it answers (StartJoinSession).
+	if (bReserveSlotBeforeJoin && RequestSlotReservation(Operation)) return;
+	StartJoinSession(MoveTemp(Operation));
+}
+void UGoSubsystem::StartJoinSession(FGoSessionOperation&& Operation)
+{
+	const FName SessionName = Operation.SessionName;
+
+	//~ Store the delegate in a FDelegateHandle while any join is in flight, so every completion is received.
+	if (GetNumInFlightSessionOperations(EGoSessionOperationType::Join) == 1)
+	{
+		JoinSessionCompleteDelegateHandle = SessionInterface->AddOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegate);
+	}
+
+	//~ JOIN
+	NamedSessions.FindOrAdd(SessionName).State = EGoSessionState::Joining;
+	const FUniqueNetIdPtr LocalUserId = GetLocalUserId();
+	if (!LocalUserId.IsValid() || !SessionInterface->JoinSession(*LocalUserId, SessionName, *Operation.SearchResult))
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("JoinSession could not be started"));
+		//~ If joining wasn't successful, clear delegate of the delegate list.
+		if (GetNumInFlightSessionOperations(EGoSessionOperationType::Join) == 1)
+		{
+			SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+		}
+		NamedSessions.FindOrAdd(SessionName).State = EGoSessionState::None;
+		//~ Broadcast Go Subsystem Delegate - Joining wasn't successful.
+		BroadcastJoinSessionComplete(FName(), EOnJoinSessionCompleteResult::UnknownError);
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Join, false, EOnJoinSessionCompleteResult::UnknownError);
+	}
+}
+bool UGoSubsystem::RequestSlotReservation(FGoSessionOperation& Operation)
+{
+	//~ Only hosts that advertise a reservation beacon can be asked.
+	const FOnlineSessionSettings& Settings = Operation.SearchResult->Session.SessionSettings;
+	int32 BeaconPort = 0;
+	FString ConnectString;
+	UWorld* World = GetWorld();
+	if (!World || !EOSGo::SessionAttributes::BeaconPort.Get(Settings, BeaconPort) || BeaconPort <= 0
+		|| !SessionInterface->GetResolvedConnectString(*Operation.SearchResult, NAME_BeaconPort, ConnectString)) return false;
+
+	AGoReservationBeaconClient* Beacon = World->SpawnActor<AGoReservationBeaconClient>();
+	if (!Beacon) return false;
+
+	FString HostSessionName = NAME_GameSession.ToString();
+	EOSGo::SessionAttributes::HostSessionName.Get(Settings, HostSessionName);
+	const FName SessionName = Operation.SessionName;
+	Beacon->OnReservationComplete.BindUObject(this, &ThisClass::OnSlotReservationComplete, SessionName);
+	FGoPendingSlotReservation& Pending = PendingSlotReservations.Add(SessionName);
+	Pending.Operation = MoveTemp(Operation);
+	Pending.Beacon = Beacon;
+	if (!Beacon->RequestReservation(ConnectString, FName(HostSessionName)))
+	{
+		//~ A failure reported from inside the request has already resumed the join.
+		FGoPendingSlotReservation NotStarted;
+		if (!PendingSlotReservations.RemoveAndCopyValue(SessionName, NotStarted)) return true;
+		Beacon->OnReservationComplete.Unbind();
+		Beacon->DestroyBeacon();
+		Operation = MoveTemp(NotStarted.Operation);
+		return false;
+	}
+	return true;
+}
+void UGoSubsystem::OnSlotReservationComplete(EGoSlotReservationResult Result, const FString& Token, FName SessionName)
+{
+	FGoPendingSlotReservation Pending;
+	if (!PendingSlotReservations.RemoveAndCopyValue(SessionName, Pending)) return;
+
+	//~ Turned down by the host: handled as a join that found the session full, which fails over to the next candidate.
+	if (Result == EGoSlotReservationResult::Full)
+	{
+		UE_LOG(LogEOSGoSession, Log, TEXT("Host has no open slot, skipping the join"));
+		OnJoinSessionComplete(SessionName, EOnJoinSessionCompleteResult::SessionIsFull);
+		return;
+	}
+
+	//~ Hosts that couldn't be asked are still joined; they admit unreserved players while they have room.
+	NamedSessions.FindOrAdd(SessionName).ReservationToken = Token;
+	StartJoinSession(MoveTemp(Pending.Operation));
+}
+void UGoSubsystem::SetReservationBeaconPort(int32 Port)
+{
+	if (Port == ReservationBeaconPort) return;
+	ReservationBeaconPort = Port;
+	if (!SessionInterface.IsValid()) return;
+
+	//~ Sessions hosted before the beacon started listening advertise it through an update (ExecuteUpdateSession adds the port),
+	//~ and stop advertising it the same way once it closed.
+	for (const FName SessionName : GetSessionNames())
+	{
+		const FNamedOnlineSession* Session = SessionInterface->GetNamedSession(SessionName);
+		if (!Session || !Session->bHosting) continue;
+
+		FOnlineSessionSettings UpdatedSettings = Session->SessionSettings;
+		UpdateSession(UpdatedSettings, SessionName);
+	}
+}
+
+
+void UGoSubsystem::OnDestroySessionComplete(FName SessionName, bool bWasSuccess)
+{
+	if (!IsSessionOperationInFlight(SessionName, EGoSessionOperationType::Destroy)) return;
+
+	//~ If every destruction has completed, clear delegate of the delegate list.
+	if (SessionInterface && GetNumInFlightSessionOperations(EGoSessionOperationType::Destroy) <= 1)
+	{
+		SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+	}
+
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+	if (bWasSuccess || !SessionInterface || SessionInterface->GetNamedSession(SessionName) == nullptr)
+	{
+		Session.State = EGoSessionState::None;
+		Session.MatchType = NAME_None;
+	}
+	else
+	{
+		Session.State = Session.StateBeforeDestroy;
+	}
+	
+	//~ Broadcast Go Subsystem Delegate - Destroying was successful.
+	UE_LOG(LogEOSGoSession, Log, TEXT("Destroying session: %s "), *SessionName.ToString());
+	if (SessionName == NAME_GameSession) GoOnDestroySessionComplete.Broadcast(bWasSuccess);
+	FinishSessionOperation(SessionName, EGoSessionOperationType::Destroy, bWasSuccess);
+}
+int32 UGoSubsystem::GoDestroySession(FName SessionName, FGoOnRequestComplete OnComplete)
+{
+	if (!SessionInterface.IsValid() && SessionName == NAME_GameSession) GoOnDestroySessionComplete.Broadcast(false);
+
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Destroy;
+	Operation.SessionName = SessionName;
+	return RequestSessionOperation(MoveTemp(Operation), MoveTemp(OnComplete));
+}
+void UGoSubsystem::ExecuteDestroySession(FGoSessionOperation&& Operation)
+{
+	const FName SessionName = Operation.SessionName;
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+
+	//~ Nothing to destroy, skip the backend round trip.
+	if (SessionInterface->GetNamedSession(SessionName) == nullptr)
+	{
+		Session.State = EGoSessionState::None;
+		if (SessionName == NAME_GameSession) GoOnDestroySessionComplete.Broadcast(false);
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Destroy, false);
+		return;
+	}
+
+	//~ Store the delegate in a FDelegateHandle while any destruction is in flight, so every completion is received.
+	if (GetNumInFlightSessionOperations(EGoSessionOperationType::Destroy) == 1)
+	{
+		DestroySessionCompleteDelegateHandle = SessionInterface->AddOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegate);
+	}
+	
+	//~ DESTROY
+	Session.StateBeforeDestroy = Session.State;
+	Session.State = EGoSessionState::Destroying;
+	if (!SessionInterface->DestroySession(SessionName))
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("DestroySession could not be started"));
+		//~ If destroying wasn't successful, clear delegate of the delegate list.
+		if (GetNumInFlightSessionOperations(EGoSessionOperationType::Destroy) == 1)
+		{
+			SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+		}
+		FGoNamedSession& KeptSession = NamedSessions.FindOrAdd(SessionName);
+		KeptSession.State = KeptSession.StateBeforeDestroy;
+		//~ Broadcast Go Subsystem Delegate - Destroying wasn't successful.
+		if (SessionName == NAME_GameSession) GoOnDestroySessionComplete.Broadcast(false);
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Destroy, false);
+	}
+}
+
+
+void UGoSubsystem::OnStartSessionComplete(FName SessionName, bool bWasSuccess)
+{
+	if (!IsSessionOperationInFlight(SessionName, EGoSessionOperationType::Start)) return;
+
+	//~ If every start has completed, clear delegate of the delegate list.
+	if (SessionInterface && GetNumInFlightSessionOperations(EGoSessionOperationType::Start) <= 1)
+	{
+		SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
+	}
+
+	NamedSessions.FindOrAdd(SessionName).State = bWasSuccess ? EGoSessionState::InProgress : EGoSessionState::Pending;
+
+	//~ Broadcast Go Subsystem Delegate - Starting was successful.
+	UE_LOG(LogEOSGoSession, Log, TEXT("Starting session: %s "), *SessionName.ToString());
+	if (SessionName == NAME_GameSession) GoOnStartSessionComplete.Broadcast(bWasSuccess);
+	FinishSessionOperation(SessionName, EGoSessionOperationType::Start, bWasSuccess);
+}
+int32 UGoSubsystem::GoStartSession(FName SessionName, FGoOnRequestComplete OnComplete)
+{
+	if (!SessionInterface.IsValid() && SessionName == NAME_GameSession) GoOnStartSessionComplete.Broadcast(false);
+
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Start;
+	Operation.SessionName = SessionName;
+	return RequestSessionOperation(MoveTemp(Operation), MoveTemp(OnComplete));
+}
+void UGoSubsystem::ExecuteStartSession(FGoSessionOperation&& Operation)
+{
+	const FName SessionName = Operation.SessionName;
+	FGoNamedSession& Session = NamedSessions.FindOrAdd(SessionName);
+
+	//~ Already started, skip the backend round trip.
+	if (Session.State == EGoSessionState::InProgress)
+	{
+		if (SessionName == NAME_GameSession) GoOnStartSessionComplete.Broadcast(true);
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Start, true);
+		return;
+	}
+
+	//~ Store the delegate in a FDelegateHandle while any start is in flight, so every completion is received.
+	if (GetNumInFlightSessionOperations(EGoSessionOperationType::Start) == 1)
+	{
+		StartSessionCompleteDelegateHandle = SessionInterface->AddOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegate);
+	}
+	
+	//~ START
+	Session.State = EGoSessionState::Starting;
+	if (!SessionInterface->StartSession(SessionName))
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("StartSession could not be started"));
+		//~ If starting wasn't successful, clear delegate of the delegate list.
+		if (GetNumInFlightSessionOperations(EGoSessionOperationType::Start) == 1)
+		{
+			SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
+		}
+		NamedSessions.FindOrAdd(SessionName).State = EGoSessionState::Pending;
+		//~ Broadcast Go Subsystem Delegate - Starting wasn't successful.
+		if (SessionName == NAME_GameSession) GoOnStartSessionComplete.Broadcast(false);
+		FinishSessionOperation(SessionName, EGoSessionOperationType::Start, false);
+	}	
+}
+
+
+bool UGoSubsystem::CancelRequest(int32 RequestId)
+{
+	if (RequestId == 0) return false;
+
+	FGoRequest Request;
+	FName SessionName;
+	if (SessionOperations.TakeRequest(RequestId, Request, SessionName))
+	{
+		Request.Cancel(SessionName);
+		return true;
+	}
+	for (FGoInFlightSessionOperation& InFlight : InFlightSessionOperations)
+	{
+		if (!TakeGoRequest(InFlight.Requests, RequestId, Request)) continue;
+
+		//~ A ranked join nobody waits for stops failing over.
+		if (InFlight.Type == EGoSessionOperationType::Join && InFlight.Requests.IsEmpty()) InFlight.FailoverCandidates.Reset();
+		SessionName = InFlight.SessionName;
+		Request.Cancel(SessionName);
+		return true;
+	}
+	if (TakeGoRequest(BackgroundLoginRequests, RequestId, Request) || TakeGoRequest(LoginRequests, RequestId, Request))
+	{
+		Request.Cancel(NAME_None);
+		return true;
+	}
+	if (TakeGoRequest(FindSessionByIdRequests, RequestId, Request))
+	{
+		Request.Cancel(NAME_None);
+		return true;
+	}
+	if (TakeGoRequest(QuickMatch.Requests, RequestId, Request))
+	{
+		if (QuickMatch.Requests.IsEmpty() && QuickMatch.Stage != EGoQuickMatchStage::None) FinishQuickMatch(false, false);
+		Request.Cancel(NAME_GameSession);
+		return true;
+	}
+
+	const int32 FindIndex = PendingFindSessionsRequests.IndexOfByPredicate([RequestId](const FGoPendingFindSessionsRequest& Pending) { return Pending.Request.RequestId == RequestId; });
+	if (FindIndex != INDEX_NONE)
+	{
+		const FGoPendingFindSessionsRequest Cancelled = MoveTemp(PendingFindSessionsRequests[FindIndex]);
+		PendingFindSessionsRequests.RemoveAt(FindIndex);
+		if (!PendingFindSessionsRequests.ContainsByPredicate([&Cancelled](const FGoPendingFindSessionsRequest& Pending) { return Pending.Query == Cancelled.Query; })
+			&& !HasStreamingSearchRequests(Cancelled.Query))
+		{
+			PendingSearchQueries.Remove(Cancelled.Query);
+		}
+		Cancelled.Request.Cancel(NAME_None, TArray<FOnlineSessionSearchResult>());
+		return true;
+	}
+	for (FGoDeferredFindSessionsResults& Deferred : DeferredFindSessionsResults)
+	{
+		FGoFindSessionsRequest FindRequest;
+		if (!TakeGoRequest(Deferred.Requests, RequestId, FindRequest)) continue;
+
+		FindRequest.Cancel(NAME_None, TArray<FOnlineSessionSearchResult>());
+		return true;
+	}
+
+	FGoStreamingSearchRequest Streaming;
+	if (TakeStreamingSearchRequest(RequestId, Streaming))
+	{
+		//~ Unlike a plain search, a streaming one nobody waits for is stopped, in flight or queued.
+		if (!HasStreamingSearchRequests(Streaming.Query)
+			&& !PendingFindSessionsRequests.ContainsByPredicate([&Streaming](const FGoPendingFindSessionsRequest& Pending) { return Pending.Query == Streaming.Query; }))
+		{
+			PendingSearchQueries.Remove(Streaming.Query);
+		}
+		if (InFlightSearchQuery.IsSet() && InFlightSearchQuery.GetValue() == Streaming.Query) CancelFindSessionsIfUnwanted();
+		UpdateSearchStreaming();
+		Streaming.Request.Cancel(NAME_None);
+		return true;
+	}
+	return false;
+}
+void UGoSubsystem::CancelAllRequests()
+{
+	TArray<FGoRequest> Requests = SessionOperations.TakeAllRequests();
+	for (FGoInFlightSessionOperation& InFlight : InFlightSessionOperations)
+	{
+		Requests.Append(MoveTemp(InFlight.Requests));
+		InFlight.Requests.Reset();
+	}
+	Requests.Append(MoveTemp(BackgroundLoginRequests));
+	Requests.Append(MoveTemp(LoginRequests));
+	Requests.Append(MoveTemp(QuickMatch.Requests));
+	Requests.Append(MoveTemp(FindSessionByIdRequests));
+	BackgroundLoginRequests.Reset();
+	LoginRequests.Reset();
+	QuickMatch.Requests.Reset();
+	FindSessionByIdRequests.Reset();
+	for (const FGoStreamingSearchRequest& Streaming : StreamingSearchRequests)
+	{
+		Requests.Add(Streaming.Request);
+	}
+	StreamingSearchRequests.Reset();
+	UpdateSearchStreaming();
+	const TArray<FGoPendingFindSessionsRequest> FindRequests = MoveTemp(PendingFindSessionsRequests);
+	PendingFindSessionsRequests.Reset();
+	const TArray<FGoDeferredFindSessionsResults> Deferred = MoveTemp(DeferredFindSessionsResults);
+	DeferredFindSessionsResults.Reset();
+	if (DeferredFindSessionsTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredFindSessionsTickerHandle);
+		DeferredFindSessionsTickerHandle.Reset();
+	}
+
+	for (const FGoRequest& Request : Requests)
+	{
+		Request.Cancel(NAME_None);
+	}
+	for (const FGoPendingFindSessionsRequest& Pending : FindRequests)
+	{
+		Pending.Request.Cancel(NAME_None, TArray<FOnlineSessionSearchResult>());
+	}
+	for (const FGoDeferredFindSessionsResults& Held : Deferred)
+	{
+		for (const FGoFindSessionsRequest& Request : Held.Requests) Request.Cancel(NAME_None, TArray<FOnlineSessionSearchResult>());
+	}
+}
+void UGoSubsystem::EnqueueSessionOperation(FGoSessionOperation&& Operation)
+{
+	SessionOperations.Enqueue(MoveTemp(Operation));
+	ProcessSessionOperations();
+}
+int32 UGoSubsystem::RequestSessionOperation(FGoSessionOperation&& Operation, FGoOnRequestComplete&& OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	RequestSessionOperation(MoveTemp(Operation), MoveTemp(Request));
+	return RequestId;
+}
+void UGoSubsystem::RequestSessionOperation(FGoSessionOperation&& Operation, FGoRequest&& Request)
+{
+	if (!SessionInterface.IsValid())
+	{
+		Request.Complete(false, Operation.SessionName, 0);
+		return;
+	}
+
+	Operation.Requests.Add(MoveTemp(Request));
+	EnqueueSessionOperation(MoveTemp(Operation));
+}
+void UGoSubsystem::ProcessSessionOperations()
+{
+	//~ Issue queued operations in order while they don't conflict with the ones in flight.
+	FGoSessionOperation Operation;
+	while (SessionInterface.IsValid() && SessionOperations.PopReady(InFlightSessionOperations, Operation))
+	{
+		//~ Mark it in flight before issuing it, the backend may complete synchronously.
+		InFlightSessionOperations.Add({Operation.SessionName, Operation.Type, MoveTemp(Operation.Requests), MoveTemp(Operation.FailoverCandidates)});
+		FGoOperationMetrics::Get().Begin(GetOnlineOperation(Operation.Type), 0, Operation.SessionName);
+		switch (Operation.Type)
+		{
+		case EGoSessionOperationType::Create: ExecuteCreateSession(MoveTemp(Operation)); break;
+		case EGoSessionOperationType::Update: ExecuteUpdateSession(MoveTemp(Operation)); break;
+		case EGoSessionOperationType::Start: ExecuteStartSession(MoveTemp(Operation)); break;
+		case EGoSessionOperationType::Join: ExecuteJoinSession(MoveTemp(Operation)); break;
+		case EGoSessionOperationType::Destroy: ExecuteDestroySession(MoveTemp(Operation)); break;
+		}
+	}
+}
+void UGoSubsystem::FinishSessionOperation(FName SessionName, EGoSessionOperationType Type, bool bWasSuccess, int32 Detail)
+{
+	FGoOperationMetrics::Get().End(GetOnlineOperation(Type), bWasSuccess, Detail, SessionName);
+	TArray<FGoRequest> Requests = TakeInFlightRequests(SessionName, Type);
+	InFlightSessionOperations.RemoveSingle({SessionName, Type});
+	GoOnSessionOperationComplete.Broadcast(SessionName, Type, bWasSuccess);
+	CompleteGoRequests(Requests, bWasSuccess, SessionName, Detail);
+	ProcessSessionOperations();
+}
+TArray<FGoRequest> UGoSubsystem::TakeInFlightRequests(FName SessionName, EGoSessionOperationType Type)
+{
+	FGoInFlightSessionOperation* InFlight = InFlightSessionOperations.FindByKey(FGoInFlightSessionOperation{SessionName, Type});
+	return InFlight ? MoveTemp(InFlight->Requests) : TArray<FGoRequest>();
+}
+int32 UGoSubsystem::GetNumInFlightSessionOperations(EGoSessionOperationType Type) const
+{
+	int32 Count = 0;
+	for (const FGoInFlightSessionOperation& InFlight : InFlightSessionOperations)
+	{
+		if (InFlight.Type == Type) ++Count;
+	}
+	return Count;
+}
+void UGoSubsystem::DestroyBeforeSessionOperation(FGoSessionOperation&& Operation)
+{
+	//~ The Destroy queued before it left the session in place: fail now rather than destroy again and again.
+	if (Operation.bIsAfterDestroy)
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("Session %s could not be destroyed to make way for a new one"), *Operation.SessionName.ToString());
+		if (Operation.Type == EGoSessionOperationType::Create)
+		{
+			BroadcastCreateSessionComplete(Operation.SessionName, false);
+			FinishSessionOperation(Operation.SessionName, EGoSessionOperationType::Create, false);
+		}
+		else
+		{
+			BroadcastJoinSessionComplete(Operation.SessionName, EOnJoinSessionCompleteResult::AlreadyInSession);
+			FinishSessionOperation(Operation.SessionName, EGoSessionOperationType::Join, false, EOnJoinSessionCompleteResult::AlreadyInSession);
+		}
+		return;
+	}
+
+	//~ Requeue the operation behind a Destroy, both ahead of anything queued later. Its requests and candidates wait with it.
+	const FGoInFlightSessionOperation InFlight{Operation.SessionName, Operation.Type};
+	if (FGoInFlightSessionOperation* Issued = InFlightSessionOperations.FindByKey(InFlight))
+	{
+		Operation.FailoverCandidates = MoveTemp(Issued->FailoverCandidates);
+	}
+	Operation.Requests = TakeInFlightRequests(InFlight.SessionName, InFlight.Type);
+	Operation.bIsAfterDestroy = true;
+	SessionOperations.PushFront(MoveTemp(Operation));
+
+	FGoSessionOperation Destroy;
+	Destroy.Type = EGoSessionOperationType::Destroy;
+	Destroy.SessionName = InFlight.SessionName;
+	SessionOperations.PushFront(MoveTemp(Destroy));
+
+	InFlightSessionOperations.RemoveSingle(InFlight);
+	const EGoSessionOperationType Type = InFlight.Type;
+	FGoOperationMetrics::Get().Cancel(GetOnlineOperation(Type), InFlight.SessionName);
+}
+EGoOnlineOperation UGoSubsystem::GetOnlineOperation(EGoSessionOperationType Type)
+{
+	switch (Type)
+	{
+	case EGoSessionOperationType::Create: return EGoOnlineOperation::Create;
+	case EGoSessionOperationType::Update: return EGoOnlineOperation::Update;
+	case EGoSessionOperationType::Start: return EGoOnlineOperation::Start;
+	case EGoSessionOperationType::Join: return EGoOnlineOperation::Join;
+	default: return EGoOnlineOperation::Destroy;
+	}
+}
+
+
+int32 UGoSubsystem::GoQuickMatch(FName MatchType, bool bSpeculativeHost)
+{
+	return GoQuickMatch(MatchType, bSpeculativeHost, FGoOnRequestComplete());
+}
+int32 UGoSubsystem::GoQuickMatch(FName MatchType, bool bSpeculativeHost, FGoOnRequestComplete OnComplete)
+{
+	FGoRequest Request = MakeRequest(MoveTemp(OnComplete));
+	const int32 RequestId = Request.RequestId;
+	if (!SessionInterface.IsValid() || QuickMatch.Stage != EGoQuickMatchStage::None)
+	{
+		Request.Complete(false, NAME_None, 0);
+		return RequestId;
+	}
+
+	QuickMatch = FGoQuickMatch();
+	QuickMatch.Requests.Add(MoveTemp(Request));
+	QuickMatch.MatchType = MatchType;
+
+	//~ Hosting needs the match type's capacity.
+	if (!MatchTypeRegistry.Find(MatchType))
+	{
+		UE_LOG(LogEOSGoSession, Warning, TEXT("QuickMatch needs a registered match type: %s"), *MatchType.ToString());
+		FinishQuickMatch(false, false);
+		return RequestId;
+	}
+	QuickMatch.Stage = EGoQuickMatchStage::Searching;
+
+	//~ Host if nothing joinable shows up before the deadline.
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(QuickMatch.DeadlineTimerHandle, this, &ThisClass::OnQuickMatchDeadline, FMath::Max(QuickMatchSearchDeadline, UE_KINDA_SMALL_NUMBER), false);
+	}
+
+	//~ Speculative mode hosts while searching; a join found meanwhile destroys the hosted session first.
+	if (bSpeculativeHost) StartQuickMatchHosting();
+	StartQuickMatchSearch();
+	return RequestId;
+}
+void UGoSubsystem::StartQuickMatchSearch()
+{
+	//~ Public sessions are advertised with a Server Join Id of 0. The id is kept before issuing: the search may complete at once.
+	FGoFindSessionsRequest Request = MakeRequest(FGoOnFindSessionsRequestComplete::CreateUObject(this, &ThisClass::OnQuickMatchSearchComplete));
+	QuickMatch.SearchRequestId = Request.RequestId;
+	FindSessions(FGoSessionSearchQuery{0, QuickMatch.MatchType}, MoveTemp(Request));
+}
+void UGoSubsystem::StartQuickMatchHosting()
+{
+	if (QuickMatch.CreateRequestId != 0 || QuickMatch.bHasHosted) return;
+
+	FGoSessionOperation Operation;
+	Operation.Type = EGoSessionOperationType::Create;
+	Operation.SessionName = NAME_GameSession;
+	Operation.MatchType = QuickMatch.MatchType;
+	FGoRequest Request = MakeRequest(FGoOnRequestComplete::CreateUObject(this, &ThisClass::OnQuickMatchCreateComplete));
+	QuickMatch.CreateRequestId = Request.RequestId;
+	RequestSessionOperation(MoveTemp(Operation), MoveTemp(Request));
+}
+void UGoSubsystem::OnQuickMatchSearchComplete(const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	//~ Other searches that complete meanwhile aren't this pipeline's business.
+	if (Result.RequestId != QuickMatch.SearchRequestId) return;
+	QuickMatch.SearchRequestId = 0;
+	if (QuickMatch.Stage != EGoQuickMatchStage::Searching) return;
+	if (Result.bWasCancelled)
+	{
+		FinishQuickMatch(false, false);
+		return;
+	}
+
+	//~ Never try to join the session speculatively hosted by this pipeline.
+	TArray<FOnlineSessionSearchResult> Candidates = SessionResults;
+	if (const FNamedOnlineSession* OwnSession = SessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		const FString OwnSessionId = OwnSession->GetSessionIdStr();
+		Candidates.RemoveAll([&OwnSessionId](const FOnlineSessionSearchResult& Result) { return Result.GetSessionIdStr() == OwnSessionId; });
+	}
+	RankJoinCandidates(Candidates, QuickMatch.MatchType);
+
+	if (!Candidates.IsEmpty())
+	{
+		QuickMatch.Stage = EGoQuickMatchStage::Joining;
+		FGoRequest Request = MakeRequest(FGoOnRequestComplete::CreateUObject(this, &ThisClass::OnQuickMatchJoinComplete));
+		QuickMatch.JoinRequestId = Request.RequestId;
+		JoinRankedCandidates(MoveTemp(Candidates), MoveTemp(Request));
+		return;
+	}
+
+	//~ Nothing to join: a speculatively hosted session wins right away.
+	if (QuickMatch.bHasHosted)
+	{
+		FinishQuickMatch(true, true);
+		return;
+	}
+	if (QuickMatch.bDeadlinePassed)
+	{
+		QuickMatch.Stage = EGoQuickMatchStage::Hosting;
+		StartQuickMatchHosting();
+		return;
+	}
+
+	//~ Search again with fresh results until the deadline.
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(QuickMatch.RetryTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (QuickMatch.Stage != EGoQuickMatchStage::Searching) return;
+			InvalidateSessionSearchCache();
+			StartQuickMatchSearch();
+		}), FMath::Max(QuickMatchRetryInterval, UE_KINDA_SMALL_NUMBER), false);
+	}
+}
+void UGoSubsystem::OnQuickMatchJoinComplete(const FGoRequestResult& Result)
+{
+	if (Result.RequestId != QuickMatch.JoinRequestId) return;
+	QuickMatch.JoinRequestId = 0;
+	if (QuickMatch.Stage != EGoQuickMatchStage::Joining) return;
+	if (Result.bWasCancelled)
+	{
+		FinishQuickMatch(false, false);
+		return;
+	}
+
+	if (Result.bWasSuccessful)
+	{
+		FinishQuickMatch(true, false);
+		return;
+	}
+
+	//~ Every candidate failed: search again while there is time left, otherwise host.
+	QuickMatch.bHasHosted = false;
+	if (QuickMatch.bDeadlinePassed)
+	{
+		QuickMatch.Stage = EGoQuickMatchStage::Hosting;
+		StartQuickMatchHosting();
+		return;
+	}
+	QuickMatch.Stage = EGoQuickMatchStage::Searching;
+	InvalidateSessionSearchCache();
+	StartQuickMatchSearch();
+}
+void UGoSubsystem::OnQuickMatchCreateComplete(const FGoRequestResult& Result)
+{
+	if (Result.RequestId != QuickMatch.CreateRequestId) return;
+	QuickMatch.CreateRequestId = 0;
+	QuickMatch.bHasHosted = Result.bWasSuccessful;
+
+	//~ While still searching, the hosted session is kept until the search or the deadline settles it.
+	if (QuickMatch.Stage == EGoQuickMatchStage::Hosting)
+	{
+		FinishQuickMatch(Result.bWasSuccessful, true);
+	}
+}
+void UGoSubsystem::OnQuickMatchDeadline()
+{
+	QuickMatch.bDeadlinePassed = true;
+	if (QuickMatch.Stage != EGoQuickMatchStage::Searching) return;
+
+	//~ The search lost: stop it and use (or create) a hosted session.
+	if (QuickMatch.bHasHosted)
+	{
+		FinishQuickMatch(true, true);
+		return;
+	}
+	CancelQuickMatchRequest(QuickMatch.SearchRequestId);
+	CancelFindSessionsIfUnwanted();
+	QuickMatch.Stage = EGoQuickMatchStage::Hosting;
+	StartQuickMatchHosting();
+}
+void UGoSubsystem::CancelQuickMatchRequest(int32& RequestId)
+{
+	//~ Cleared first, so the cancelled request's callback isn't taken for the pipeline's own answer.
+	const int32 Outstanding = RequestId;
+	RequestId = 0;
+	if (Outstanding != 0) CancelRequest(Outstanding);
+}
+void UGoSubsystem::FinishQuickMatch(bool bWasSuccess, bool bIsHost)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(QuickMatch.DeadlineTimerHandle);
+		World->GetTimerManager().ClearTimer(QuickMatch.RetryTimerHandle);
+	}
+	QuickMatch.Stage = EGoQuickMatchStage::None;
+
+	//~ The paths that lost are stopped. Without a match, the session this pipeline hosted or is joining is left too.
+	const bool bLeaveSession = !bWasSuccess && (QuickMatch.bHasHosted
+		|| (QuickMatch.CreateRequestId != 0 && IsSessionOperationInFlight(NAME_GameSession, EGoSessionOperationType::Create))
+		|| (QuickMatch.JoinRequestId != 0 && IsSessionOperationInFlight(NAME_GameSession, EGoSessionOperationType::Join)));
+	CancelQuickMatchRequest(QuickMatch.SearchRequestId);
+	CancelQuickMatchRequest(QuickMatch.JoinRequestId);
+	CancelQuickMatchRequest(QuickMatch.CreateRequestId);
+	CancelFindSessionsIfUnwanted();
+	if (bLeaveSession)
+	{
+		QuickMatch.bHasHosted = false;
+		GoDestroySession(NAME_GameSession);
+	}
+
+	UE_LOG(LogEOSGoSession, Log, TEXT("QuickMatch finished (%s, %s)"), bWasSuccess ? TEXT("success") : TEXT("failure"), bIsHost ? TEXT("host") : TEXT("client"));
+	GoOnQuickMatchComplete.Broadcast(bWasSuccess, bIsHost);
+	CompleteGoRequests(QuickMatch.Requests, bWasSuccess, NAME_GameSession, bIsHost ? 1 : 0);
+}
+
+
+void UGoSubsystem::PreloadMap(const FString& MapUrl)
+{
+	//~ Only the map of the URL is loaded; options such as ?listen are for the travel.
+	const FURL Url(nullptr, *MapUrl, TRAVEL_Absolute);
+	const FName PackageName(*Url.Map);
+	if (!FPackageName::IsValidLongPackageName(Url.Map))
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("PreloadMap: %s is not a map package"), *MapUrl);
+		return;
+	}
+	if (PackageName == PreloadingMapPackage) return;
+
+	ReleasePreloadedMap();
+	PreloadingMapPackage = PackageName;
+	UE_LOG(LogEOSGo, Log, TEXT("Preloading %s"), *Url.Map);
+	LoadPackageAsync(Url.Map, FLoadPackageAsyncDelegate::CreateUObject(this, &ThisClass::OnMapPreloaded));
+}
+void UGoSubsystem::ReleasePreloadedMap()
+{
+	//~ A load still in flight completes unreferenced and is collected with the next garbage collection.
+	PreloadingMapPackage = NAME_None;
+	PreloadedWorld = nullptr;
+}
+void UGoSubsystem::OnMapPreloaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	if (PackageName != PreloadingMapPackage) return;
+
+	//~ Holding the world keeps the map and everything it references resident until the travel loads it.
+	PreloadedWorld = Result == EAsyncLoadingResult::Succeeded && Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!PreloadedWorld)
+	{
+		UE_LOG(LogEOSGo, Warning, TEXT("Preloading %s failed"), *PackageName.ToString());
+		PreloadingMapPackage = NAME_None;
+		return;
+	}
+	UE_LOG(LogEOSGo, Log, TEXT("Preloaded %s"), *PackageName.ToString());
+}
+void UGoSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	//~ The travel has loaded the map (or another one): the preload served its purpose either way.
+	if (!PreloadingMapPackage.IsNone()) ReleasePreloadedMap();
 }
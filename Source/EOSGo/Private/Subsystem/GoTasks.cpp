@@ -0,0 +1,137 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "Subsystem/GoTasks.h"
+#include "OnlineSessionSettings.h"
+
+namespace
+{
+	FGoRequestResult& GetRequestResult(FGoRequestResult& Result) { return Result; }
+	FGoRequestResult& GetRequestResult(FGoFindSessionsResult& Result) { return Result.Request; }
+
+	//~ Owned by the request's callback. A callback destroyed without running still completes the task, as cancelled.
+	template <typename ResultType>
+	struct TGoTaskCompletion
+	{
+		UE::Tasks::FTaskEvent Event{TEXT("EOSGo request")};
+		const TSharedRef<ResultType> Result = MakeShared<ResultType>();
+		bool bIsCompleted = false;
+
+		~TGoTaskCompletion()
+		{
+			if (bIsCompleted) return;
+			GetRequestResult(*Result).bWasCancelled = true;
+			Event.Trigger();
+		}
+		void Complete()
+		{
+			bIsCompleted = true;
+			Event.Trigger();
+		}
+	};
+
+	FGoOnRequestComplete MakeCallback(const TSharedRef<TGoTaskCompletion<FGoRequestResult>>& Completion)
+	{
+		return FGoOnRequestComplete::CreateLambda([Completion](const FGoRequestResult& Result)
+		{
+			*Completion->Result = Result;
+			Completion->Complete();
+		});
+	}
+	FGoOnFindSessionsRequestComplete MakeCallback(const TSharedRef<TGoTaskCompletion<FGoFindSessionsResult>>& Completion)
+	{
+		return FGoOnFindSessionsRequestComplete::CreateLambda([Completion](const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults)
+		{
+			Completion->Result->Request = Result;
+			Completion->Result->SessionResults = SessionResults;
+			Completion->Complete();
+		});
+	}
+
+	template <typename ResultType, typename IssueType>
+	TGoTask<ResultType> LaunchGoTask(IssueType&& Issue)
+	{
+		const TSharedRef<TGoTaskCompletion<ResultType>> Completion = MakeShared<TGoTaskCompletion<ResultType>>();
+
+		//~ Inline: the result is handed over on the thread that completes the request, without waiting for a worker.
+		TGoTask<ResultType> Task;
+		Task.Task = UE::Tasks::Launch(TEXT("EOSGo request"), [Result = Completion->Result] { return *Result; },
+			UE::Tasks::Prerequisites(Completion->Event), UE::Tasks::ETaskPriority::Normal, UE::Tasks::EExtendedTaskPriority::Inline);
+		Task.RequestId = Issue(MakeCallback(Completion));
+		return Task;
+	}
+}
+
+namespace EOSGo::Tasks
+{
+	FGoRequestTask Login(UGoSubsystem& Subsystem, const FString& Id, const FString& Token, const FString& LoginType)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoEOSLogin(Id, Token, LoginType, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask AutoLogin(UGoSubsystem& Subsystem)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoAutoLogin(MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask InteractiveLogin(UGoSubsystem& Subsystem)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoInteractiveLogin(MoveTemp(OnComplete)); });
+	}
+
+	FGoRequestTask CreateSession(UGoSubsystem& Subsystem, int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession, FName SessionName)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete)
+		{
+			return Subsystem.GoCreateSession(NumberOfConnections, MatchType, ServerPrivateJoinId, bIsPrivateSession, SessionName, MoveTemp(OnComplete));
+		});
+	}
+	FGoRequestTask HostDedicatedSession(UGoSubsystem& Subsystem, FName MatchType, int32 NumberOfConnections)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoHostDedicatedSession(MatchType, NumberOfConnections, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask HostDedicatedLobby(UGoSubsystem& Subsystem, FName MatchType, int32 NumberOfConnections)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete)
+		{
+			FName SessionName;
+			return Subsystem.GoHostDedicatedLobby(MatchType, NumberOfConnections, MoveTemp(OnComplete), SessionName);
+		});
+	}
+	FGoRequestTask UpdateSession(UGoSubsystem& Subsystem, const FOnlineSessionSettings& UpdateSessionSettings, FName SessionName)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.UpdateSession(UpdateSessionSettings, SessionName, MoveTemp(OnComplete)); });
+	}
+	FGoFindSessionsTask FindSessions(UGoSubsystem& Subsystem, int64 ServerJoinId, FName MatchType)
+	{
+		return LaunchGoTask<FGoFindSessionsResult>([&](FGoOnFindSessionsRequestComplete&& OnComplete) { return Subsystem.GoFindSessions(ServerJoinId, MatchType, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask JoinSession(UGoSubsystem& Subsystem, const FOnlineSessionSearchResult& SessionSearchResult)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoJoinSession(SessionSearchResult, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask JoinBestSession(UGoSubsystem& Subsystem, const TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoJoinBestSession(SessionResults, PreferredMatchType, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask FindAndJoinSession(UGoSubsystem& Subsystem, int64 ServerJoinId, FName MatchType, FGoSessionSearchPredicate JoinPredicate, FGoOnFindSessionsBatch OnBatch)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete)
+		{
+			return Subsystem.GoFindAndJoinSession(ServerJoinId, MatchType, MoveTemp(JoinPredicate), MoveTemp(OnBatch), MoveTemp(OnComplete));
+		});
+	}
+	FGoRequestTask JoinSessionByCode(UGoSubsystem& Subsystem, const FString& JoinCode)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoJoinSessionByCode(JoinCode, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask StartSession(UGoSubsystem& Subsystem, FName SessionName)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoStartSession(SessionName, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask DestroySession(UGoSubsystem& Subsystem, FName SessionName)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoDestroySession(SessionName, MoveTemp(OnComplete)); });
+	}
+	FGoRequestTask QuickMatch(UGoSubsystem& Subsystem, FName MatchType, bool bSpeculativeHost)
+	{
+		return LaunchGoTask<FGoRequestResult>([&](FGoOnRequestComplete&& OnComplete) { return Subsystem.GoQuickMatch(MatchType, bSpeculativeHost, MoveTemp(OnComplete)); });
+	}
+}
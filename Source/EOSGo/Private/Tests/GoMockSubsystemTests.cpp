@@ -0,0 +1,479 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+#include "Misc/AutomationTest.h"
+#include "Subsystem/GoSubsystem.h"
+#include "Subsystem/GoMockOnlineBackend.h"
+#include "Game/GoGameModeBase.h"
+#include "EOSGo.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "OnlineSessionSettings.h"
+
+namespace
+{
+	//~ Longest a latent step waits for a mock request to be answered.
+	constexpr double AnswerTimeoutSeconds = 5.0;
+
+	/**
+	 * A standalone game instance whose UGoSubsystem runs against the mock backend, with short latencies and no random
+	 * failures. Shared by the latent commands of a test; the last one to finish shuts it down and restores the cvars.
+	 */
+	class FGoMockTestContext
+	{
+	public:
+		FGoMockTestContext()
+		{
+			SetConsoleVariable(TEXT("EOSGo.Mock.Enabled"), TEXT("1"));
+			SetConsoleVariable(TEXT("EOSGo.Mock.LatencyMs"), TEXT("5"));
+			SetConsoleVariable(TEXT("EOSGo.Mock.LatencyJitterMs"), TEXT("0"));
+			SetConsoleVariable(TEXT("EOSGo.Mock.FailureRate"), TEXT("0"));
+			SetConsoleVariable(TEXT("EOSGo.Mock.SearchBatches"), TEXT("1"));
+
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+			GoSubsystem = GameInstance->GetSubsystem<UGoSubsystem>();
+		}
+		~FGoMockTestContext()
+		{
+			//~ Mock sessions outlive the game instance; leave none behind for the next test.
+			if (const IOnlineSessionPtr Sessions = EOSGo::GetSessionInterface())
+			{
+				if (GoSubsystem)
+				{
+					for (const FName SessionName : GoSubsystem->GetSessionNames()) Sessions->RemoveNamedSession(SessionName);
+				}
+				Sessions->RemoveNamedSession(NAME_GameSession);
+			}
+
+			UWorld* World = GameInstance->GetWorld();
+			GameInstance->Shutdown();
+			GameInstance->RemoveFromRoot();
+			if (World)
+			{
+				GEngine->DestroyWorldContext(World);
+				World->DestroyWorld(false);
+			}
+			FGoMockOnlineBackend::Get().Reset();
+
+			for (const TPair<FString, FString>& Saved : SavedValues)
+			{
+				if (IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Saved.Key)) Variable->Set(*Saved.Value, ECVF_SetByCode);
+			}
+		}
+
+		//~ Sets a cvar for the rest of the test; its value from before the test is restored afterwards.
+		void SetConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+		{
+			IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+			if (!Variable) return;
+
+			if (!SavedValues.Contains(Name)) SavedValues.Add(Name, Variable->GetString());
+			Variable->Set(Value, ECVF_SetByCode);
+		}
+
+		UWorld* GetWorld() const { return GameInstance->GetWorld(); }
+
+		UGoSubsystem* GoSubsystem = nullptr;
+
+	private:
+		UGameInstance* GameInstance = nullptr;
+		TMap<FString, FString> SavedValues;
+	};
+
+	//~ Answer of one request, filled in by its callback.
+	struct FGoTestAnswer
+	{
+		TOptional<FGoRequestResult> Result;
+		int32 NumResults = 0;
+
+		bool WasSuccessful() const { return Result.IsSet() && Result->bWasSuccessful; }
+	};
+	FGoOnRequestComplete MakeCallback(const TSharedRef<FGoTestAnswer>& Answer)
+	{
+		return FGoOnRequestComplete::CreateLambda([Answer](const FGoRequestResult& Result) { Answer->Result = Result; });
+	}
+	FGoOnFindSessionsRequestComplete MakeFindCallback(const TSharedRef<FGoTestAnswer>& Answer)
+	{
+		return FGoOnFindSessionsRequestComplete::CreateLambda([Answer](const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults)
+		{
+			Answer->Result = Result;
+			Answer->NumResults = SessionResults.Num();
+		});
+	}
+
+	//~ Latent step that waits until every answer arrived, failing the test if one takes longer than AnswerTimeoutSeconds.
+	void AddWaitForAnswers(FAutomationTestBase& Test, TArray<TSharedRef<FGoTestAnswer>> Answers)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Answers, StartTime = TOptional<double>()]() mutable
+		{
+			if (!StartTime.IsSet()) StartTime = FPlatformTime::Seconds();
+			if (!Answers.ContainsByPredicate([](const TSharedRef<FGoTestAnswer>& Answer) { return !Answer->Result.IsSet(); })) return true;
+			if (FPlatformTime::Seconds() - StartTime.GetValue() < AnswerTimeoutSeconds) return false;
+
+			Test.AddError(TEXT("A mock request was not answered in time"));
+			return true;
+		}));
+	}
+	//~ Latent step that waits for DelaySeconds.
+	void AddWait(double DelaySeconds)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([DelaySeconds, StartTime = TOptional<double>()]() mutable
+		{
+			if (!StartTime.IsSet()) StartTime = FPlatformTime::Seconds();
+			return FPlatformTime::Seconds() - StartTime.GetValue() >= DelaySeconds;
+		}));
+	}
+	//~ Latent step that ticks the world's timers until Condition holds, failing the test after AnswerTimeoutSeconds.
+	//~ The standalone test world isn't ticked by the engine; game mode batching runs on its timers.
+	void AddTickUntil(FAutomationTestBase& Test, const TSharedRef<FGoMockTestContext>& Context, const TCHAR* What, TFunction<bool()> Condition)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Context, What, Condition = MoveTemp(Condition), StartTime = TOptional<double>()]() mutable
+		{
+			if (!StartTime.IsSet()) StartTime = FPlatformTime::Seconds();
+			if (UWorld* World = Context->GetWorld()) World->GetTimerManager().Tick(FApp::GetDeltaTime());
+			if (Condition()) return true;
+			if (FPlatformTime::Seconds() - StartTime.GetValue() < AnswerTimeoutSeconds) return false;
+
+			Test.AddError(FString::Printf(TEXT("Timed out waiting for: %s"), What));
+			return true;
+		}));
+	}
+	//~ Logs the mock user in, as every session request needs a local user.
+	void AddLogin(FAutomationTestBase& Test, const TSharedRef<FGoMockTestContext>& Context)
+	{
+		const TSharedRef<FGoTestAnswer> Login = MakeShared<FGoTestAnswer>();
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, Login]
+		{
+			Context->GoSubsystem->GoEOSLogin(TEXT("mock"), FString(), TEXT("developer"), MakeCallback(Login));
+			return true;
+		}));
+		AddWaitForAnswers(Test, {Login});
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Login]
+		{
+			Test.TestTrue(TEXT("Mock login succeeded"), Login->WasSuccessful());
+			return true;
+		}));
+	}
+
+	//~ A joinable session hosted by HostName, as a search would have returned it.
+	FOnlineSessionSearchResult MakeSearchResult(const FString& HostName, int32 PingInMs)
+	{
+		const IOnlineIdentityPtr Identity = EOSGo::GetIdentityInterface();
+		FOnlineSessionSearchResult Result;
+		Result.Session.OwningUserName = HostName;
+		Result.Session.OwningUserId = Identity->CreateUniquePlayerId(HostName);
+		Result.Session.SessionSettings.NumPublicConnections = 4;
+		Result.Session.NumOpenPublicConnections = 3;
+		Result.Session.SessionInfo = MakeShared<FGoMockSessionInfo>(Identity->CreateUniquePlayerId(HostName + TEXT("_Session")).ToSharedRef(), TEXT("127.0.0.1:7777"));
+		Result.PingInMs = PingInMs;
+		return Result;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockCollapsedStartTest, "EOSGo.Mock.CollapsedStart",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockCollapsedStartTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	AddLogin(*this, Context);
+
+	//~ Both starts queue behind the create and go to the backend as one.
+	const TSharedRef<FGoTestAnswer> Create = MakeShared<FGoTestAnswer>();
+	const TSharedRef<FGoTestAnswer> FirstStart = MakeShared<FGoTestAnswer>();
+	const TSharedRef<FGoTestAnswer> SecondStart = MakeShared<FGoTestAnswer>();
+	const TSharedRef<int32> StartsBefore = MakeShared<int32>(0);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, Create, FirstStart, SecondStart, StartsBefore]
+	{
+		*StartsBefore = Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Start);
+		Context->GoSubsystem->GoCreateSession(4, TEXT("DUO"), 0, false, NAME_GameSession, MakeCallback(Create));
+		Context->GoSubsystem->GoStartSession(NAME_GameSession, MakeCallback(FirstStart));
+		Context->GoSubsystem->GoStartSession(NAME_GameSession, MakeCallback(SecondStart));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {Create, FirstStart, SecondStart});
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, Create, FirstStart, SecondStart, StartsBefore]
+	{
+		TestTrue(TEXT("Create succeeded"), Create->WasSuccessful());
+		TestTrue(TEXT("First start succeeded"), FirstStart->WasSuccessful());
+		TestTrue(TEXT("Second start succeeded"), SecondStart->WasSuccessful());
+		TestEqual(TEXT("Backend starts"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Start) - *StartsBefore, 1);
+		return true;
+	}));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockJoinFailoverTest, "EOSGo.Mock.JoinFailover",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockJoinFailoverTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	AddLogin(*this, Context);
+
+	//~ The best ranked candidate fails to join; the runner-up is joined instead.
+	const TSharedRef<FGoTestAnswer> Join = MakeShared<FGoTestAnswer>();
+	const TSharedRef<int32> JoinsBefore = MakeShared<int32>(0);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, Join, JoinsBefore]
+	{
+		*JoinsBefore = Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Join);
+		TArray<FOnlineSessionSearchResult> Candidates;
+		Candidates.Add(MakeSearchResult(TEXT("RunnerUpHost"), 100));
+		Candidates.Add(MakeSearchResult(TEXT("BestHost"), 10));
+
+		//~ The mock rolls a request's outcome when it is issued, and only the first join is issued right away.
+		Context->SetConsoleVariable(TEXT("EOSGo.Mock.FailureRate"), TEXT("1"));
+		Context->GoSubsystem->GoJoinBestSession(Candidates, NAME_None, MakeCallback(Join));
+		Context->SetConsoleVariable(TEXT("EOSGo.Mock.FailureRate"), TEXT("0"));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {Join});
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, Join, JoinsBefore]
+	{
+		TestTrue(TEXT("Join succeeded after failing over"), Join->WasSuccessful());
+		TestEqual(TEXT("Backend joins"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Join) - *JoinsBefore, 2);
+		const FNamedOnlineSession* Session = EOSGo::GetSessionInterface()->GetNamedSession(NAME_GameSession);
+		TestTrue(TEXT("Joined the runner-up"), Session && Session->OwningUserName == TEXT("RunnerUpHost"));
+		return true;
+	}));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockConcurrentJoinCodesTest, "EOSGo.Mock.ConcurrentJoinCodes",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockConcurrentJoinCodesTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	AddLogin(*this, Context);
+
+	const FName LobbySession(TEXT("Lobby"));
+	const TSharedRef<FGoTestAnswer> Create = MakeShared<FGoTestAnswer>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, Create, LobbySession]
+	{
+		Context->GoSubsystem->GoCreateSession(4, TEXT("DUO"), 0, false, LobbySession, MakeCallback(Create));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {Create});
+
+	//~ A second code lookup while the first is in flight runs alongside it instead of failing.
+	const TSharedRef<FGoTestAnswer> FirstJoin = MakeShared<FGoTestAnswer>();
+	const TSharedRef<FGoTestAnswer> SecondJoin = MakeShared<FGoTestAnswer>();
+	const TSharedRef<int32> FindsBefore = MakeShared<int32>(0);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, Create, FirstJoin, SecondJoin, FindsBefore, LobbySession]
+	{
+		TestTrue(TEXT("Create succeeded"), Create->WasSuccessful());
+		const FString JoinCode = Context->GoSubsystem->GetNamedSessionJoinCode(LobbySession);
+		*FindsBefore = Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Find);
+		Context->GoSubsystem->GoJoinSessionByCode(JoinCode, MakeCallback(FirstJoin));
+		Context->GoSubsystem->GoJoinSessionByCode(JoinCode, MakeCallback(SecondJoin));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {FirstJoin, SecondJoin});
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, FirstJoin, SecondJoin, FindsBefore]
+	{
+		TestTrue(TEXT("First join by code succeeded"), FirstJoin->WasSuccessful());
+		TestTrue(TEXT("Second join by code succeeded"), SecondJoin->WasSuccessful());
+		TestEqual(TEXT("Backend lookups"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Find) - *FindsBefore, 2);
+		return true;
+	}));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockCancelQuickMatchTest, "EOSGo.Mock.CancelSpeculativeQuickMatch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockCancelQuickMatchTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	//~ Nothing to join, and no deadline within the test: the quick match keeps searching next to its hosted session.
+	Context->SetConsoleVariable(TEXT("EOSGo.Mock.RemoteSessions"), TEXT("0"));
+	Context->GoSubsystem->QuickMatchSearchDeadline = 60.f;
+	AddLogin(*this, Context);
+
+	const TSharedRef<FGoTestAnswer> QuickMatch = MakeShared<FGoTestAnswer>();
+	const TSharedRef<int32> QuickMatchId = MakeShared<int32>(0);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, QuickMatch, QuickMatchId]
+	{
+		*QuickMatchId = Context->GoSubsystem->GoQuickMatch(TEXT("DUO"), true, MakeCallback(QuickMatch));
+		return true;
+	}));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, StartTime = TOptional<double>()]() mutable
+	{
+		if (!StartTime.IsSet()) StartTime = FPlatformTime::Seconds();
+		const FNamedOnlineSession* Session = EOSGo::GetSessionInterface()->GetNamedSession(NAME_GameSession);
+		if (Session && Session->SessionState != EOnlineSessionState::Creating) return true;
+		if (FPlatformTime::Seconds() - StartTime.GetValue() < AnswerTimeoutSeconds) return false;
+
+		AddError(TEXT("The speculative session was not hosted in time"));
+		return true;
+	}));
+
+	//~ Cancelling stops the search and leaves the hosted session.
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, QuickMatch, QuickMatchId]
+	{
+		TestTrue(TEXT("Quick match is cancelled"), Context->GoSubsystem->CancelRequest(*QuickMatchId));
+		TestTrue(TEXT("Quick match answers as cancelled"), QuickMatch->Result.IsSet() && QuickMatch->Result->bWasCancelled);
+		TestFalse(TEXT("Quick match is over"), Context->GoSubsystem->IsQuickMatchInProgress());
+		return true;
+	}));
+	AddWait(0.5);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this]
+	{
+		TestNull(TEXT("No named session is left"), EOSGo::GetSessionInterface()->GetNamedSession(NAME_GameSession));
+		return true;
+	}));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockRegistrationBurstTest, "EOSGo.Mock.RegistrationBurst",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockRegistrationBurstTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	AddLogin(*this, Context);
+
+	const TSharedRef<FGoTestAnswer> Create = MakeShared<FGoTestAnswer>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, Create]
+	{
+		Context->GoSubsystem->GoCreateSession(4, TEXT("DUO"), 0, false, NAME_GameSession, MakeCallback(Create));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {Create});
+
+	//~ Results per player, as a roster listening to the game mode sees them.
+	struct FBurstState
+	{
+		TWeakObjectPtr<AGoGameModeBase> GameMode;
+		TArray<FUniqueNetIdRef> Players;
+		TMap<FString, int32> Registered;
+		int32 UnregistrationsBefore = 0;
+	};
+	const TSharedRef<FBurstState> State = MakeShared<FBurstState>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, Create, State]
+	{
+		TestTrue(TEXT("Create succeeded"), Create->WasSuccessful());
+		AGoGameModeBase* GameMode = Context->GetWorld() ? Context->GetWorld()->SpawnActor<AGoGameModeBase>() : nullptr;
+		if (!TestNotNull(TEXT("Game mode"), GameMode)) return true;
+
+		GameMode->RegistrationBatchWindow = 0.2f;
+		GameMode->GoOnRegisterPlayerResult.AddLambda([State](const FUniqueNetIdRef& PlayerId, bool bWasSuccess)
+		{
+			if (bWasSuccess) ++State->Registered.FindOrAdd(PlayerId->ToString());
+		});
+		State->GameMode = GameMode;
+
+		//~ A burst of arrivals goes out as one batch.
+		const IOnlineIdentityPtr Identity = EOSGo::GetIdentityInterface();
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			State->Players.Add(Identity->CreateUniquePlayerId(FString::Printf(TEXT("BurstPlayer%d"), Index)).ToSharedRef());
+			GameMode->GoRegisterPlayerId(State->Players.Last());
+		}
+		return true;
+	}));
+	AddTickUntil(*this, Context, TEXT("the burst to be registered"), [State]
+	{
+		return State->Registered.Num() == State->Players.Num();
+	});
+
+	//~ One player leaves and rejoins within the batch window: nothing reaches the backend, and it is reported registered again.
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, State]
+	{
+		if (!State->GameMode.IsValid()) return true;
+		State->UnregistrationsBefore = Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::UnregisterPlayers);
+		State->GameMode->GoUnregisterPlayerId(State->Players[0]);
+		State->GameMode->GoRegisterPlayerId(State->Players[0]);
+		return true;
+	}));
+	AddTickUntil(*this, Context, TEXT("the rejoined player to be reported"), [State]
+	{
+		return !State->Players.IsEmpty() && State->Registered.FindRef(State->Players[0]->ToString()) == 2;
+	});
+	AddWait(0.3);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, State]
+	{
+		if (State->GameMode.IsValid()) State->GameMode->FlushPendingRegistrations();
+		TestEqual(TEXT("Backend unregistrations"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::UnregisterPlayers) - State->UnregistrationsBefore, 0);
+		for (int32 Index = 1; Index < State->Players.Num(); ++Index)
+		{
+			TestEqual(TEXT("Players that stayed are reported once"), State->Registered.FindRef(State->Players[Index]->ToString()), 1);
+		}
+		return true;
+	}));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoMockSearchCacheTest, "EOSGo.Mock.SearchCacheTimeToLive",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoMockSearchCacheTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGoMockTestContext> Context = MakeShared<FGoMockTestContext>();
+	if (!TestNotNull(TEXT("GoSubsystem"), Context->GoSubsystem)) return false;
+	constexpr float TimeToLive = 0.5f;
+	Context->GoSubsystem->FindSessionsCacheTimeToLive = TimeToLive;
+	Context->GoSubsystem->InvalidateSessionSearchCache();
+	AddLogin(*this, Context);
+
+	const TSharedRef<int32> FindsBefore = MakeShared<int32>(0);
+	const TSharedRef<FGoTestAnswer> FirstFind = MakeShared<FGoTestAnswer>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, FirstFind, FindsBefore]
+	{
+		*FindsBefore = Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Find);
+		Context->GoSubsystem->GoFindSessions(0, TEXT("DUO"), MakeFindCallback(FirstFind));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {FirstFind});
+
+	//~ Within the time-to-live the same query is answered from the cache, still never from inside the call.
+	const TSharedRef<FGoTestAnswer> CachedFind = MakeShared<FGoTestAnswer>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, CachedFind]
+	{
+		Context->GoSubsystem->GoFindSessions(0, TEXT("DUO"), MakeFindCallback(CachedFind));
+		TestFalse(TEXT("Cached search answers on a later tick"), CachedFind->Result.IsSet());
+		return true;
+	}));
+	AddWaitForAnswers(*this, {CachedFind});
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, FirstFind, CachedFind, FindsBefore]
+	{
+		TestTrue(TEXT("First search succeeded"), FirstFind->WasSuccessful());
+		TestTrue(TEXT("Cached search succeeded"), CachedFind->WasSuccessful());
+		TestEqual(TEXT("Cached search has the same results"), CachedFind->NumResults, FirstFind->NumResults);
+		TestEqual(TEXT("Backend searches within the time-to-live"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Find) - *FindsBefore, 1);
+		return true;
+	}));
+
+	//~ Once it expired, the query goes to the backend again.
+	AddWait(TimeToLive + 0.1);
+	const TSharedRef<FGoTestAnswer> ExpiredFind = MakeShared<FGoTestAnswer>();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Context, ExpiredFind]
+	{
+		Context->GoSubsystem->GoFindSessions(0, TEXT("DUO"), MakeFindCallback(ExpiredFind));
+		return true;
+	}));
+	AddWaitForAnswers(*this, {ExpiredFind});
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Context, ExpiredFind, FindsBefore]
+	{
+		TestTrue(TEXT("Search after expiry succeeded"), ExpiredFind->WasSuccessful());
+		TestEqual(TEXT("Backend searches after the time-to-live"), Context->GoSubsystem->GetOperationCount(EGoOnlineOperation::Find) - *FindsBefore, 2);
+		return true;
+	}));
+	return true;
+}
+
+#endif
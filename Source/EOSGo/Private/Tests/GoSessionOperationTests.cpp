@@ -0,0 +1,143 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "OnlineSessionSettings.h"
+#include "Subsystem/GoSessionOperation.h"
+#include "Subsystem/GoSessionSearchCache.h"
+
+namespace
+{
+	FGoSessionOperation MakeOperation(EGoSessionOperationType Type, int32 RequestId, FName SessionName = NAME_GameSession)
+	{
+		FGoSessionOperation Operation;
+		Operation.Type = Type;
+		Operation.SessionName = SessionName;
+		Operation.Requests.Add(FGoRequest{RequestId});
+		return Operation;
+	}
+	TArray<int32> GetRequestIds(const FGoSessionOperation& Operation)
+	{
+		TArray<int32> RequestIds;
+		for (const FGoRequest& Request : Operation.Requests) RequestIds.Add(Request.RequestId);
+		return RequestIds;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoSessionOperationQueueCollapseTest, "EOSGo.SessionOperationQueue.Collapse",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoSessionOperationQueueCollapseTest::RunTest(const FString& Parameters)
+{
+	FGoSessionOperationQueue Queue;
+	const TArray<FGoInFlightSessionOperation> NothingInFlight;
+
+	//~ Back to back creates: the latest settings win and both requests get the answer.
+	FGoSessionOperation FirstCreate = MakeOperation(EGoSessionOperationType::Create, 1);
+	FirstCreate.MatchType = TEXT("DUO");
+	FGoSessionOperation SecondCreate = MakeOperation(EGoSessionOperationType::Create, 2);
+	SecondCreate.MatchType = TEXT("SQUAD");
+	TestTrue(TEXT("First create is queued"), Queue.Enqueue(MoveTemp(FirstCreate)));
+	TestFalse(TEXT("Second create collapses"), Queue.Enqueue(MoveTemp(SecondCreate)));
+
+	//~ Starts and updates behind it collapse into one each.
+	TestTrue(TEXT("First start is queued"), Queue.Enqueue(MakeOperation(EGoSessionOperationType::Start, 3)));
+	TestFalse(TEXT("Second start collapses"), Queue.Enqueue(MakeOperation(EGoSessionOperationType::Start, 4)));
+	FGoSessionOperation FirstUpdate = MakeOperation(EGoSessionOperationType::Update, 5);
+	FirstUpdate.UpdateSettings = MakeShared<FOnlineSessionSettings>();
+	FirstUpdate.UpdateSettings->NumPublicConnections = 2;
+	FGoSessionOperation SecondUpdate = MakeOperation(EGoSessionOperationType::Update, 6);
+	SecondUpdate.UpdateSettings = MakeShared<FOnlineSessionSettings>();
+	SecondUpdate.UpdateSettings->NumPublicConnections = 4;
+	TestTrue(TEXT("First update is queued"), Queue.Enqueue(MoveTemp(FirstUpdate)));
+	TestFalse(TEXT("Second update collapses"), Queue.Enqueue(MoveTemp(SecondUpdate)));
+
+	//~ Another named session is independent.
+	TestTrue(TEXT("Create of another session is queued"), Queue.Enqueue(MakeOperation(EGoSessionOperationType::Create, 7, TEXT("Lobby"))));
+
+	FGoSessionOperation Operation;
+	TestTrue(TEXT("Create is ready"), Queue.PopReady(NothingInFlight, Operation));
+	TestTrue(TEXT("Create type"), Operation.Type == EGoSessionOperationType::Create);
+	TestEqual(TEXT("Create keeps the latest match type"), Operation.MatchType, FName(TEXT("SQUAD")));
+	TestTrue(TEXT("Create answers both requests"), GetRequestIds(Operation) == TArray<int32>{1, 2});
+
+	//~ Nothing else of the game session runs while its create is in flight; the lobby's create does.
+	TArray<FGoInFlightSessionOperation> InFlight;
+	InFlight.Add({NAME_GameSession, EGoSessionOperationType::Create});
+	TestTrue(TEXT("Lobby create is ready"), Queue.PopReady(InFlight, Operation));
+	TestEqual(TEXT("Lobby create session"), Operation.SessionName, FName(TEXT("Lobby")));
+	TestFalse(TEXT("Start waits for the create"), Queue.PopReady(InFlight, Operation));
+
+	TestTrue(TEXT("Start is ready"), Queue.PopReady(NothingInFlight, Operation));
+	TestTrue(TEXT("Start type"), Operation.Type == EGoSessionOperationType::Start);
+	TestTrue(TEXT("Start answers both requests"), GetRequestIds(Operation) == TArray<int32>{3, 4});
+
+	TestTrue(TEXT("Update is ready"), Queue.PopReady(NothingInFlight, Operation));
+	TestTrue(TEXT("Update type"), Operation.Type == EGoSessionOperationType::Update);
+	TestTrue(TEXT("Update keeps the latest settings"), Operation.UpdateSettings.IsValid() && Operation.UpdateSettings->NumPublicConnections == 4);
+	TestTrue(TEXT("Update answers both requests"), GetRequestIds(Operation) == TArray<int32>{5, 6});
+
+	TestTrue(TEXT("Queue is drained"), Queue.IsEmpty());
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoSessionOperationQueueLifecycleTest, "EOSGo.SessionOperationQueue.LifecycleBoundary",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoSessionOperationQueueLifecycleTest::RunTest(const FString& Parameters)
+{
+	FGoSessionOperationQueue Queue;
+
+	//~ A start past a destroy acts on the next session, so it must not collapse into the one before it.
+	Queue.Enqueue(MakeOperation(EGoSessionOperationType::Start, 1));
+	Queue.Enqueue(MakeOperation(EGoSessionOperationType::Destroy, 2));
+	TestTrue(TEXT("Start after a destroy is queued"), Queue.Enqueue(MakeOperation(EGoSessionOperationType::Start, 3)));
+
+	//~ A create past a join isn't the latest request for a new session, so it doesn't replace the earlier create.
+	FGoSessionOperationQueue JoinQueue;
+	JoinQueue.Enqueue(MakeOperation(EGoSessionOperationType::Create, 4));
+	JoinQueue.Enqueue(MakeOperation(EGoSessionOperationType::Join, 5));
+	TestTrue(TEXT("Create after a join is queued"), JoinQueue.Enqueue(MakeOperation(EGoSessionOperationType::Create, 6)));
+
+	//~ Failover candidates travel with their join: back to back joins keep the latest join's runners-up, not a mix.
+	FGoSessionOperationQueue FailoverQueue;
+	FGoSessionOperation FirstJoin = MakeOperation(EGoSessionOperationType::Join, 7);
+	FirstJoin.FailoverCandidates.Add(MakeShared<FOnlineSessionSearchResult>());
+	FirstJoin.FailoverCandidates.Add(MakeShared<FOnlineSessionSearchResult>());
+	FGoSessionOperation SecondJoin = MakeOperation(EGoSessionOperationType::Join, 8);
+	const TSharedPtr<FOnlineSessionSearchResult> RunnerUp = MakeShared<FOnlineSessionSearchResult>();
+	SecondJoin.FailoverCandidates.Add(RunnerUp);
+	FailoverQueue.Enqueue(MoveTemp(FirstJoin));
+	FailoverQueue.Enqueue(MoveTemp(SecondJoin));
+	FGoSessionOperation Ready;
+	TestTrue(TEXT("Collapsed join is ready"), FailoverQueue.PopReady(TArray<FGoInFlightSessionOperation>(), Ready));
+	TestTrue(TEXT("Collapsed join keeps the latest candidates"), Ready.FailoverCandidates.Num() == 1 && Ready.FailoverCandidates[0] == RunnerUp);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGoSessionSearchCacheTest, "EOSGo.SessionSearchCache.TimeToLive",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FGoSessionSearchCacheTest::RunTest(const FString& Parameters)
+{
+	FGoSessionSearchCache Cache;
+	const FGoSessionSearchQuery DuoQuery{0, TEXT("DUO")};
+	const FGoSessionSearchQuery SquadQuery{0, TEXT("SQUAD")};
+	const TSharedRef<FOnlineSessionSearch> Search = MakeShared<FOnlineSessionSearch>();
+	Cache.Add(DuoQuery, Search);
+
+	TestTrue(TEXT("Fresh search is found"), Cache.Find(DuoQuery, 60.f) == Search);
+	TestFalse(TEXT("Other queries miss"), Cache.Find(SquadQuery, 60.f).IsValid());
+	TestFalse(TEXT("A zero time-to-live never hits"), Cache.Find(DuoQuery, 0.f).IsValid());
+	TestFalse(TEXT("Expired entries are dropped"), Cache.Find(DuoQuery, 60.f).IsValid());
+
+	Cache.Add(DuoQuery, Search);
+	Cache.Invalidate();
+	TestFalse(TEXT("Invalidate drops every entry"), Cache.Find(DuoQuery, 60.f).IsValid());
+	return true;
+}
+
+#endif
@@ -27,6 +27,10 @@ bool UGoMenu::Initialize()
 	{
 		JoinLobby_Button->OnClicked.AddDynamic(this, &UGoMenu::JoinLobbyButtonClicked);
 	}
+	if (QuickMatch_Button)
+	{
+		QuickMatch_Button->OnClicked.AddDynamic(this, &UGoMenu::QuickMatchButtonClicked);
+	}
 	if (Quit_Button)
 	{
 		Quit_Button->OnClicked.AddDynamic(this, &UGoMenu::QuitButtonClicked);
@@ -64,135 +68,130 @@ void UGoMenu::GoMenuSetup(FString LobbyMapPath)
 		GoSubsystem = GameInstance->GetSubsystem<UGoSubsystem>();
 	}
 
-	if (IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get())
-	{
-		SessionInterface = Subsystem->GetSessionInterface();
-	}
-	
-	if (IsValid(GoSubsystem))
-	{
-		//~ Bind session callbacks.
-		GoSubsystem->GoOnCreateSessionComplete.AddDynamic(this, &UGoMenu::OnCreateSession);
-		GoSubsystem->GoOnFindSessionsComplete.AddUObject(this, &UGoMenu::OnFindSessions);
-		GoSubsystem->GoOnJoinSessionComplete.AddUObject(this, &UGoMenu::OnJoinSession);
-	}
+	SessionInterface = EOSGo::GetSessionInterface();
 }
 
-void UGoMenu::OnCreateSession(bool bWasSuccessful)
+void UGoMenu::OnCreateSession(const FGoRequestResult& Result)
 {
-	if (bWasSuccessful)
+	if (Result.bWasSuccessful)
 	{
-		LogMessage("Session created successfully!");
+		UE_LOG(LogEOSGoSession, Log, TEXT("Session created successfully!"));
 		if (UWorld* World = GetWorld()) World->ServerTravel(LobbyMap);
 	}
 	else
 	{
-		LogMessage("Failed creating session!");
+		UE_LOG(LogEOSGoSession, Warning, TEXT("Failed creating session!"));
+		if (IsValid(GoSubsystem)) GoSubsystem->ReleasePreloadedMap();
 		HostLobby_Button->SetIsEnabled(true);
 	}
 }
 
-void UGoMenu::OnFindSessions(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
+void UGoMenu::OnJoinSession(const FGoRequestResult& Result)
 {
 	//~ Validations
-	if (!IsValid(GoSubsystem)) return;
-	if (!bWasSuccessful)
+	if (!Result.bWasSuccessful)
 	{
-		LogMessage("Search was not successful!");
+		if (Result.Detail == EOnJoinSessionCompleteResult::SessionDoesNotExist) UE_LOG(LogEOSGoSearch, Log, TEXT("No sessions found!"));
+		if (IsValid(GoSubsystem)) GoSubsystem->ReleasePreloadedMap();
 		JoinLobby_Button->SetIsEnabled(true);
 		return;
 	}
-	if (SessionResults.IsEmpty())
+
+	TravelToJoinedSession();
+}
+
+void UGoMenu::OnQuickMatch(const FGoRequestResult& Result)
+{
+	if (!Result.bWasSuccessful)
 	{
-		LogMessage("No sessions found!");
-		JoinLobby_Button->SetIsEnabled(true);
+		UE_LOG(LogEOSGoSession, Warning, TEXT("Quick match failed!"));
+		if (IsValid(GoSubsystem)) GoSubsystem->ReleasePreloadedMap();
+		SetSessionButtonsEnabled(true);
 		return;
 	}
-	
-	//~ Session Results Filter & Join
-	for (const auto& Result : SessionResults)
+
+	//~ Detail tells whether the quick match hosted.
+	if (Result.Detail != 0)
 	{
-		GoSubsystem->GoJoinSession(Result);
+		if (UWorld* World = GetWorld()) World->ServerTravel(LobbyMap);
 		return;
 	}
+	TravelToJoinedSession();
 }
 
-void UGoMenu::OnJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+void UGoMenu::TravelToJoinedSession()
 {
-	//~ Validations
-	if (Result != EOnJoinSessionCompleteResult::Success)
+	if (!SessionInterface.IsValid() || !IsValid(GoSubsystem)) 
 	{
-		JoinLobby_Button->SetIsEnabled(true);
-		return;
-	}
-	if (!SessionInterface.IsValid()) 
-	{
-		LogMessage("Invalid Session Interface!");
+		UE_LOG(LogEOSGoSession, Error, TEXT("Invalid Session Interface!"));
 		return;
 	}
 
-	//~ TRAVEL
+	//~ TRAVEL - the URL routes this player to the host's session when the server hosts several.
 	FString ConnectionInfo;
-	SessionInterface->GetResolvedConnectString(NAME_GameSession, ConnectionInfo);
+	GoSubsystem->GetJoinedSessionTravelUrl(ConnectionInfo);
 	
 	if (!ConnectionInfo.IsEmpty())
 	{
 		if (APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController())
 		{
-			LogMessage("Traveling...");
+			UE_LOG(LogEOSGo, Log, TEXT("Traveling..."));
 			PlayerController->ClientTravel(ConnectionInfo, TRAVEL_Absolute);
 			return;
 		}
-		LogMessage("Player could not travel. ClientTravel Failed!");
+		UE_LOG(LogEOSGo, Warning, TEXT("Player could not travel. ClientTravel Failed!"));
 	}
 }
 
 void UGoMenu::LoginButtonClicked()
 {
 	if (!IsValid(GoSubsystem)) return;
-	
-	FString LoginType = "";
-	FString Token = "";
-	FString Id = "";
-	
-	if (FParse::Value(FCommandLine::Get(), TEXT("-AUTH_TYPE="), LoginType))
-	{
-		if (FParse::Value(FCommandLine::Get(), TEXT("-AUTH_TOKEN="), Token))
-		{
-			if (FParse::Value(FCommandLine::Get(), TEXT("-AUTH_ID="), Id))
-			{
-				LogMessage("Login Auth Data Retrived: AUTH_TYPE=" + LoginType + " | AUTH_TOKEN=" + Token + " | AUTH_ID=" + Id);
-			}
-		}
-	}
 
-	//~ Call Login 
-	if (LoginType != "" && Token != "" && Id != "")
-	{
-		GoSubsystem->GoEOSLogin(Id,Token,LoginType);
-	}
-	else
-	{
-		GoSubsystem->GoEOSLogin("","","accountportal");
-	}
+	//~ Call Login - completes at once if the background login already did.
+	GoSubsystem->GoInteractiveLogin();
 }
 
 void UGoMenu::HostLobbyButtonClicked()
 {
 	HostLobby_Button->SetIsEnabled(false);
-	ServerJoinId = FMath::RandRange(10000,99999);
 
-	//~ Call create session
-	if (GoSubsystem) GoSubsystem->GoCreateSession(NumberOfConnections, MatchType, ServerJoinId, bIsPrivate);
+	//~ Call create session - the lobby loads while the session is created. Players join it with the code the lobby overlay shows.
+	if (!GoSubsystem) return;
+	GoSubsystem->PreloadMap(LobbyMap);
+	GoSubsystem->GoCreateSession(NumberOfConnections, MatchType, 0, bIsPrivate, NAME_GameSession,
+		FGoOnRequestComplete::CreateUObject(this, &UGoMenu::OnCreateSession));
 }
 
 void UGoMenu::JoinLobbyButtonClicked()
 {
 	JoinLobby_Button->SetIsEnabled(false);
 
-	//~ Call find sessions
-	if (GoSubsystem) GoSubsystem->GoFindSessions(ServerJoinId);
+	//~ Join by code, or find sessions - hosts travel to the same lobby, so it loads while searching and joining.
+	if (GoSubsystem)
+	{
+		GoSubsystem->PreloadMap(LobbyMap);
+		if (!JoinCode.IsEmpty()) GoSubsystem->GoJoinSessionByCode(JoinCode, FGoOnRequestComplete::CreateUObject(this, &UGoMenu::OnJoinSession));
+		else
+		{
+			//~ Joins the best ranked session with an open slot from the first results that stream in, failing over to the others
+			//~ of that batch; of the chosen match type unless joining by id.
+			const FName JoinMatchType = ServerJoinId != 0 ? NAME_None : FName(MatchType);
+			GoSubsystem->GoFindAndJoinSession(ServerJoinId, NAME_None, UGoSubsystem::MakeJoinPredicate(JoinMatchType), FGoOnFindSessionsBatch(),
+				FGoOnRequestComplete::CreateUObject(this, &UGoMenu::OnJoinSession));
+		}
+	}
 	ServerJoinId = 0;
+	JoinCode.Empty();
+}
+
+void UGoMenu::QuickMatchButtonClicked()
+{
+	SetSessionButtonsEnabled(false);
+
+	//~ Call quick match - whether hosting or joining, the lobby is the destination.
+	if (!GoSubsystem) return;
+	GoSubsystem->PreloadMap(LobbyMap);
+	GoSubsystem->GoQuickMatch(FName(MatchType), bSpeculativeQuickMatch, FGoOnRequestComplete::CreateUObject(this, &UGoMenu::OnQuickMatch));
 }
 
 void UGoMenu::QuitButtonClicked()
@@ -200,6 +199,13 @@ void UGoMenu::QuitButtonClicked()
 	UKismetSystemLibrary::QuitGame(GetWorld(),UGameplayStatics::GetPlayerController(GetWorld(),0),EQuitPreference::Type::Quit,false);
 }
 
+void UGoMenu::SetSessionButtonsEnabled(bool bEnabled)
+{
+	HostLobby_Button->SetIsEnabled(bEnabled);
+	JoinLobby_Button->SetIsEnabled(bEnabled);
+	if (QuickMatch_Button) QuickMatch_Button->SetIsEnabled(bEnabled);
+}
+
 void UGoMenu::MenuTearDown()
 {
 	RemoveFromParent();
@@ -53,20 +53,18 @@ void UGoOverlay::GoOverlaySetup()
 	{
 		GoSubsystem = GameInstance->GetSubsystem<UGoSubsystem>();
 	}
-	
-	if (IsValid(GoSubsystem))
+
+	if (JoinCode_Text && GoSubsystem)
 	{
-		//~ Bind session callbacks.
-		GoSubsystem->GoOnDestroySessionComplete.AddDynamic(this, &UGoOverlay::OnDestroySession);
-		GoSubsystem->GoOnStartSessionComplete.AddDynamic(this, &UGoOverlay::OnStartSession);
+		JoinCode_Text->SetText(FText::FromString(GoSubsystem->GetJoinCode()));
 	}
 }
 
-void UGoOverlay::OnDestroySession(bool bWasSuccessful)
+void UGoOverlay::OnDestroySession(const FGoRequestResult& Result)
 {
-	if (!bWasSuccessful)
+	if (!Result.bWasSuccessful)
 	{
-		LogMessage("Failed destroying session!");
+		UE_LOG(LogEOSGoSession, Warning, TEXT("Failed destroying session!"));
 		ExitSession_Button->SetIsEnabled(true);
 		return;
 	}
@@ -85,14 +83,14 @@ void UGoOverlay::OnDestroySession(bool bWasSuccessful)
 			}
 		}
 	}
-	LogMessage("Session destroyed successfully!");
+	UE_LOG(LogEOSGoSession, Log, TEXT("Session destroyed successfully!"));
 }
 
-void UGoOverlay::OnStartSession(bool bWasSuccessful)
+void UGoOverlay::OnStartSession(const FGoRequestResult& Result)
 {
-	if (!bWasSuccessful)
+	if (!Result.bWasSuccessful)
 	{
-		LogMessage("Failed starting session!");
+		UE_LOG(LogEOSGoSession, Warning, TEXT("Failed starting session!"));
 		StartSession_Button->SetIsEnabled(true);
 		return;
 	}
@@ -105,7 +103,7 @@ void UGoOverlay::ExitSessionButtonClicked()
 	ExitSession_Button->SetIsEnabled(false);
 
 	//~ Call destroy session
-	if (GoSubsystem) GoSubsystem->GoDestroySession();
+	if (GoSubsystem) GoSubsystem->GoDestroySession(NAME_GameSession, FGoOnRequestComplete::CreateUObject(this, &UGoOverlay::OnDestroySession));
 }
 
 void UGoOverlay::StartSessionButtonClicked()
@@ -116,7 +114,7 @@ void UGoOverlay::StartSessionButtonClicked()
 
 		StartSession_Button->SetIsEnabled(false);
 		//~ Call start session
-		if (GoSubsystem) GoSubsystem->GoStartSession();
+		if (GoSubsystem) GoSubsystem->GoStartSession(NAME_GameSession, FGoOnRequestComplete::CreateUObject(this, &UGoOverlay::OnStartSession));
 	}
 }
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "OnlineSubsystem.h"
 
 class FEOSGoModule : public IModuleInterface
 {
@@ -15,7 +16,27 @@ public:
 	
 };
 
-static void LogMessage(FString Message)
+//~ Shipping builds only keep warnings and errors; everything below is compiled out of the binary.
+#if UE_BUILD_SHIPPING
+	#define EOSGO_LOG_COMPILE_VERBOSITY Warning
+#else
+	#define EOSGO_LOG_COMPILE_VERBOSITY All
+#endif
+
+//~ One category per operation so each can be tuned on its own (e.g. "log LogEOSGoSession Verbose").
+//~ Use UE_LOG with format strings: arguments are only evaluated when the category/verbosity is enabled.
+EOSGO_API DECLARE_LOG_CATEGORY_EXTERN(LogEOSGo, Log, EOSGO_LOG_COMPILE_VERBOSITY);
+EOSGO_API DECLARE_LOG_CATEGORY_EXTERN(LogEOSGoAuth, Log, EOSGO_LOG_COMPILE_VERBOSITY);
+EOSGO_API DECLARE_LOG_CATEGORY_EXTERN(LogEOSGoSession, Log, EOSGO_LOG_COMPILE_VERBOSITY);
+EOSGO_API DECLARE_LOG_CATEGORY_EXTERN(LogEOSGoSearch, Log, EOSGO_LOG_COMPILE_VERBOSITY);
+EOSGO_API DECLARE_LOG_CATEGORY_EXTERN(LogEOSGoRegistration, Log, EOSGO_LOG_COMPILE_VERBOSITY);
+
+namespace EOSGo
 {
-	UE_LOG(LogTemp, Warning, TEXT("%s"), *Message);
+	//~ Stands in for a credential in logs: only its length is kept, none of its characters.
+	EOSGO_API FString RedactCredential(const FString& Credential);
+
+	//~ Online interfaces EOSGo talks to: the in-process mock backend when it is enabled (-EOSGoMock, not in Shipping), otherwise the default online subsystem's.
+	EOSGO_API IOnlineSessionPtr GetSessionInterface();
+	EOSGO_API IOnlineIdentityPtr GetIdentityInterface();
 }
@@ -4,13 +4,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Game/GoPlayerRoster.h"
+#include "Engine/TimerHandle.h"
 #include "GoGameStateBase.generated.h"
 class UGoSubsystem;
 class AGoGameModeBase;
+enum class EGoSessionOperationType : uint8;
 
 //~ GO GAME STATE DELEGATES
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerListChangedSignature, const TArray<FName>&, PlayerList);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSessionStartedSignature, bool, bWasSuccessful);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerRosterEntrySignature, const FGoPlayerRosterEntry&, Entry);
 
 /**
  * 
@@ -22,22 +26,49 @@ class EOSGO_API AGoGameStateBase : public AGameStateBase
 
 public:
 	AGoGameStateBase();
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
 	
+	//~ Whole roster as names. Kept for existing widgets; only built while something is bound.
 	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Player")
 	FOnPlayerListChangedSignature OnPlayerListChanged;
+	//~ Per-player roster callbacks, fired on server and clients.
+	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Player")
+	FOnPlayerRosterEntrySignature OnPlayerJoined;
+	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Player")
+	FOnPlayerRosterEntrySignature OnPlayerLeft;
+	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Player")
+	FOnPlayerRosterEntrySignature OnPlayerRosterEntryChanged;
 	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Session")
 	FOnSessionStartedSignature OnSessionStarted;
 
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Player")
+	const TArray<FGoPlayerRosterEntry>& GetPlayerRoster() const { return PlayerRoster.Entries; }
+	//~ Roster entries of one named session, for servers hosting several.
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Player")
+	TArray<FGoPlayerRosterEntry> GetSessionPlayerRoster(FName SessionName) const;
+	//~ Replication payload the server has sent for the roster so far, across every client.
+	uint64 GetPlayerRosterBytesSent() const { return PlayerRoster.NumBitsSent / 8; }
+
+	//~ Adds or refreshes a registered player's roster entry (server only). Called on registration and after seamless travel.
+	void AddToRoster(const APlayerState* PlayerState);
+	//~ Re-evaluates whether the session should be advertised at the end of the debounce window (server only).
+	void RefreshSessionAdvertising(FName SessionName);
+
+	//~ Roster callbacks, called by FGoPlayerRoster on clients and by the server after each edit.
+	void HandleRosterEntryAdded(const FGoPlayerRosterEntry& Entry);
+	void HandleRosterEntryRemoved(const FGoPlayerRosterEntry& Entry);
+	void HandleRosterEntryChanged(const FGoPlayerRosterEntry& Entry);
+	void HandleRosterReceived();
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	
-	UFUNCTION()
-	void OnRegisteredPlayer(bool bWasSuccessful);
-	UFUNCTION()
-	void OnUnregisteredPlayer(bool bWasSuccessful);
 	UFUNCTION()
 	void OnStartedSession(bool bWasSuccessful);
+	void OnRegisteredPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccessful);
+	void OnUnregisteredPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccessful);
+	void OnSessionOperationComplete(FName SessionName, EGoSessionOperationType Type, bool bWasSuccessful);
 
 private:
 	TObjectPtr<AGoGameModeBase> GoGameModeBase;
@@ -49,12 +80,17 @@ private:
 	UFUNCTION()
 	void OnRep_MatchStartedText() const;
 
-	UPROPERTY(ReplicatedUsing="OnRep_PlayerList")
-	TArray<FName> PlayerList;
-	UFUNCTION()
-	void OnRep_PlayerList() const;
+	UPROPERTY(Replicated)
+	FGoPlayerRoster PlayerRoster;
 
-	void CheckSessionToAdvertise(bool bIsRegisteringPlayer);
-	void UpdateSessionAdvertising(bool InShouldAdvertise);
-	void PlayerListChanged();
+	//~ Session advertising: each named session is advertised while its share of the roster and its reserved slots leave room.
+	//~ Updates for every session touched in a debounce window go out together when it ends.
+	UPROPERTY(Config, EditDefaultsOnly, Category="EOS-Go|Session")
+	float AdvertisingDebounceTime = 0.5f;
+	FTimerHandle AdvertisingDebounceTimerHandle;
+	TSet<FName> DirtyAdvertisingSessions;
+	bool ShouldAdvertiseSession(FName SessionName) const;
+	void ApplySessionAdvertising();
+	void RemoveFromRoster(const FUniqueNetIdRepl& PlayerId);
+	void BroadcastPlayerListChanged() const;
 };
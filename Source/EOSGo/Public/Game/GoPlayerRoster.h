@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "GoPlayerRoster.generated.h"
+class AGoGameStateBase;
+struct FGoPlayerRoster;
+
+UENUM(BlueprintType)
+enum class EGoPlayerRosterState : uint8
+{
+	InLobby,
+	InMatch
+};
+
+/**
+ * One registered player in the roster, tagged with the named session it registered with.
+ */
+USTRUCT(BlueprintType)
+struct EOSGO_API FGoPlayerRosterEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="EOS-Go|Player")
+	FUniqueNetIdRepl PlayerId;
+	UPROPERTY(BlueprintReadOnly, Category="EOS-Go|Player")
+	FString DisplayName;
+	UPROPERTY(BlueprintReadOnly, Category="EOS-Go|Player")
+	FName SessionName = NAME_GameSession;
+	UPROPERTY(BlueprintReadOnly, Category="EOS-Go|Player")
+	EGoPlayerRosterState State = EGoPlayerRosterState::InLobby;
+
+	//~ Client callbacks, one per replicated item.
+	void PreReplicatedRemove(const FGoPlayerRoster& InRoster) const;
+	void PostReplicatedAdd(const FGoPlayerRoster& InRoster) const;
+	void PostReplicatedChange(const FGoPlayerRoster& InRoster) const;
+};
+
+/**
+ * Delta-replicated session roster. Only added, changed and removed entries are sent to clients.
+ */
+USTRUCT()
+struct EOSGO_API FGoPlayerRoster : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGoPlayerRosterEntry> Entries;
+
+	//~ Game state notified by the client callbacks.
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AGoGameStateBase> Owner;
+
+	//~ Server-side edits. Each returns the touched entry, or null if nothing changed.
+	const FGoPlayerRosterEntry* AddOrUpdate(const FUniqueNetIdRepl& PlayerId, const FString& DisplayName, FName SessionName, EGoPlayerRosterState State);
+	bool Remove(const FUniqueNetIdRepl& PlayerId, FGoPlayerRosterEntry& OutRemoved);
+	//~ Sets the state of every entry in the named session, returning the entries that changed.
+	TArray<const FGoPlayerRosterEntry*> SetSessionStates(FName SessionName, EGoPlayerRosterState State);
+	int32 NumSessionEntries(FName SessionName) const;
+
+	//~ Client callback, once per received update after the per-item callbacks.
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		const int64 BitsBefore = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : 0;
+		const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FGoPlayerRosterEntry, FGoPlayerRoster>(Entries, DeltaParms, *this);
+		if (DeltaParms.Writer) NumBitsSent += DeltaParms.Writer->GetNumBits() - BitsBefore;
+		return bResult;
+	}
+
+	//~ Bits the server wrote for the roster, summed over every connection (packet overhead excluded).
+	uint64 NumBitsSent = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGoPlayerRoster> : public TStructOpsTypeTraitsBase2<FGoPlayerRoster>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
\ No newline at end of file
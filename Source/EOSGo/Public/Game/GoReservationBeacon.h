@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineBeaconClient.h"
+#include "OnlineBeaconHostObject.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "GoReservationBeacon.generated.h"
+
+UENUM()
+enum class EGoSlotReservationResult : uint8
+{
+	Granted,
+	//~ The host has no open slot for the session: joining would fail after the travel.
+	Full,
+	//~ The host couldn't be asked or can't hold slots (no beacon, connection failure, no AGoGameModeBase). Joining is still allowed to try.
+	Unavailable
+};
+
+DECLARE_DELEGATE_TwoParams(FGoOnSlotReservationComplete, EGoSlotReservationResult Result, const FString& Token);
+
+/**
+ * Asks a host for a slot in one of its sessions before joining it. The beacon connects to the host's reservation
+ * beacon port, which is a handshake and two RPCs instead of a full connection and map load, and is destroyed once
+ * the host answers.
+ */
+UCLASS(Transient, NotPlaceable, Config=Engine)
+class EOSGO_API AGoReservationBeaconClient : public AOnlineBeaconClient
+{
+	GENERATED_BODY()
+
+public:
+	//~ Connects to the host (a connect string resolved with NAME_BeaconPort) and requests a slot once connected. The slot is held
+	//~ for the id the beacon connection logged in with, the one the game connection's PreLogin will see.
+	bool RequestReservation(const FString& ConnectString, FName InSessionName);
+	//~ Fires once, with the token to travel with (?GoReservation=) when the slot was granted.
+	FGoOnSlotReservationComplete OnReservationComplete;
+
+	virtual void OnConnected() override;
+	virtual void OnFailure() override;
+
+	//~ Answered once per connection; later requests on the same connection are turned down.
+	UFUNCTION(Server, Reliable)
+	void ServerRequestReservation(FName RequestedSessionName);
+	UFUNCTION(Client, Reliable)
+	void ClientReservationResponse(EGoSlotReservationResult Result, const FString& Token);
+
+private:
+	FName SessionName;
+	//~ Server side: this connection already asked for a slot.
+	bool bHasRequestedReservation = false;
+	void CompleteReservation(EGoSlotReservationResult Result, const FString& Token);
+};
+
+/**
+ * Host side of the reservation beacon, registered with the server's AOnlineBeaconHost by AGoGameModeBase.
+ * Requests are answered by AGoGameModeBase::ReserveSlot.
+ */
+UCLASS(Transient, NotPlaceable, Config=Engine)
+class EOSGO_API AGoReservationBeaconHost : public AOnlineBeaconHostObject
+{
+	GENERATED_BODY()
+
+public:
+	AGoReservationBeaconHost();
+};
@@ -0,0 +1,118 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FindSessionsCallbackProxy.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Subsystem/GoRequest.h"
+#include "GoAsyncActions.generated.h"
+class UGoSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGoOnAsyncRequestComplete, int32, RequestId, FName, SessionName, int32, Detail);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGoOnAsyncFindSessionsComplete, int32, RequestId, const TArray<FBlueprintSessionResult>&, SessionResults);
+
+/**
+ * Blueprint node issuing one Go* request. It answers once, with its request's result only, and is released right after:
+ * nothing stays bound to the GoSubsystem. Cancel answers through OnCancelled (UGoSubsystem::CancelRequest).
+ */
+UCLASS(Abstract)
+class EOSGO_API UGoAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	void Cancel();
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	int32 GetRequestId() const { return RequestId; }
+
+protected:
+	//~ Registers the node with the context's game instance until it answers.
+	void Setup(const UObject* WorldContextObject);
+	//~ Returns the subsystem to issue the request on, or null if the node was cancelled or has none.
+	UGoSubsystem* BeginRequest();
+	void Finish();
+
+	TWeakObjectPtr<UGoSubsystem> GoSubsystem;
+	int32 RequestId = 0;
+	bool bIsCancelled = false;
+	bool bIsFinished = false;
+};
+
+UCLASS()
+class EOSGO_API UGoRequestAsyncAction : public UGoAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Account", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoAutoLoginAsync(UObject* WorldContextObject);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Account", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoInteractiveLoginAsync(UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoCreateSessionAsync(UObject* WorldContextObject, int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoHostDedicatedSessionAsync(UObject* WorldContextObject, FName MatchType, int32 NumberOfConnections = 0);
+	//~ The lobby's session name comes with the result.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoHostDedicatedLobbyAsync(UObject* WorldContextObject, FName MatchType, int32 NumberOfConnections = 0);
+	//~ Detail is the EOnJoinSessionCompleteResult of the join.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoJoinSessionAsync(UObject* WorldContextObject, const FBlueprintSessionResult& SessionResult);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoJoinBestSessionAsync(UObject* WorldContextObject, const TArray<FBlueprintSessionResult>& SessionResults, FName PreferredMatchType);
+	//~ Joins the first result of type MatchType (any when None) with MinOpenSlots open slots as results stream in.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoFindAndJoinSessionAsync(UObject* WorldContextObject, int64 ServerJoinId, FName MatchType, int32 MinOpenSlots = 1);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoJoinSessionByCodeAsync(UObject* WorldContextObject, const FString& JoinCode);
+	//~ Start and destroy act on the game session when SessionName is None.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoStartSessionAsync(UObject* WorldContextObject, FName SessionName);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoDestroySessionAsync(UObject* WorldContextObject, FName SessionName);
+	//~ Detail is 1 when the quick match hosted, 0 when it joined.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoRequestAsyncAction* GoQuickMatchAsync(UObject* WorldContextObject, FName MatchType, bool bSpeculativeHost = false);
+
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncRequestComplete OnSuccess;
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncRequestComplete OnFailure;
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncRequestComplete OnCancelled;
+
+	virtual void Activate() override;
+
+private:
+	static UGoRequestAsyncAction* Create(const UObject* WorldContextObject, TFunction<int32(UGoSubsystem&, FGoOnRequestComplete&&)>&& InIssueRequest);
+	void OnRequestComplete(const FGoRequestResult& Result);
+
+	TFunction<int32(UGoSubsystem&, FGoOnRequestComplete&&)> IssueRequest;
+};
+
+UCLASS()
+class EOSGO_API UGoFindSessionsAsyncAction : public UGoAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UGoFindSessionsAsyncAction* GoFindSessionsAsync(UObject* WorldContextObject, int64 ServerJoinId, FName MatchType);
+
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncFindSessionsComplete OnSuccess;
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncFindSessionsComplete OnFailure;
+	UPROPERTY(BlueprintAssignable)
+	FGoOnAsyncFindSessionsComplete OnCancelled;
+
+	virtual void Activate() override;
+
+private:
+	void OnRequestComplete(const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults);
+
+	int64 ServerJoinId = 0;
+	FName MatchType;
+};
@@ -0,0 +1,18 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Join codes players read out and type in to reach a session. A code is the session id itself in Crockford base 32
+ * (no I, L, O or U; case-insensitive; dashes and spaces ignored) with a check symbol, so two live sessions never
+ * share a code and resolving it is a FindSessionById lookup instead of a search. An EOS session id (32 hex digits)
+ * makes a 28 symbol code; it can't be shorter without a service mapping short codes to sessions.
+ */
+struct EOSGO_API FGoJoinCode
+{
+	//~ Code for a session id, grouped in blocks of four ("0K3F-9ZQ2-..."). Empty for an empty id.
+	static FString Encode(const FString& SessionId);
+	//~ Session id the code was made from. False for malformed codes or a failed check symbol (typos).
+	static bool Decode(const FString& JoinCode, FString& OutSessionId);
+};
@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Subsystem/GoOperationMetrics.h"
+#include "UObject/Object.h"
+#include "GoLoadHarness.generated.h"
+class UGameInstance;
+class UGoSubsystem;
+class AGameModeBase;
+class APlayerController;
+class UNetDriver;
+
+//~ How each load client joins and leaves the host.
+UENUM()
+enum class EGoLoadPattern : uint8
+{
+	Fill,	//~ Join once and stay.
+	Churn,	//~ Stay a random time, leave, rejoin shortly after.
+	Burst	//~ Every client leaves and rejoins at the same wall-clock instants.
+};
+
+/**
+ * Listen-server side of the load harness. Launches headless client processes (UGoLoadClient) against this host and records
+ * server frame time, PlayerList replication bytes, registration throughput and login-to-registered latency.
+ * Started with "EOSGo.Load.Start [Clients] [fill|churn|burst] [Seconds]" on a listening AGoGameModeBase; clients report their time-to-join.
+ * Compiled out of Shipping builds: Start fails and neither the console commands nor the load client exist there.
+ */
+UCLASS()
+class EOSGO_API UGoLoadHarness : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static bool Start(UWorld* InWorld, int32 NumClients, EGoLoadPattern InPattern, float Seconds);
+	//~ Terminates the clients still running and logs the report.
+	static void Stop();
+	static bool IsRunning() { return ActiveHarness != nullptr; }
+
+private:
+	bool LaunchClients(UWorld* InWorld, int32 NumClients, EGoLoadPattern InPattern, float Seconds);
+	bool Tick(float DeltaTime);
+	void OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	void OnRegisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess);
+	void Report();
+
+	static UGoLoadHarness* ActiveHarness;
+
+	TWeakObjectPtr<UWorld> World;
+	FDelegateHandle PostLoginHandle;
+	FDelegateHandle RegisterPlayerResultHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+	TArray<FProcHandle> ClientProcesses;
+	FString ReportDirectory;
+	EGoLoadPattern Pattern = EGoLoadPattern::Fill;
+
+	double StartTime = 0.0;
+	double StopTime = 0.0;
+	FGoLatencyHistogram FrameTime;
+	FGoLatencyHistogram LoginToRegistered;
+	TMap<FString, double> LoginTimes;
+	uint32 Registrations = 0;
+	uint32 FailedRegistrations = 0;
+	int32 PeakPlayers = 0;
+	uint64 RosterBytesAtStart = 0;
+	uint64 NetBytesAtStart = 0;
+};
+
+/**
+ * Headless client launched by UGoLoadHarness (-EOSGoLoadClient=<pattern>). Finds and joins the host through the GoSubsystem,
+ * travels to it and follows its churn pattern, appending every time-to-join to the harness report directory.
+ */
+UCLASS()
+class EOSGO_API UGoLoadClient : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	//~ Bound on module startup outside Shipping; only starts in processes launched by the harness.
+	static void OnStartGameInstance(UGameInstance* InGameInstance);
+
+protected:
+	UFUNCTION()
+	void OnLoginComplete(FName Username);
+	void OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful);
+	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void OnTravelFailure(UWorld* FailedWorld, ETravelFailure::Type FailureType, const FString& Error);
+	void OnNetworkFailure(UWorld* FailedWorld, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& Error);
+
+private:
+	enum class EState : uint8
+	{
+		LoggingIn,
+		Searching,
+		Joining,
+		Traveling,
+		Connected,
+		Waiting
+	};
+
+	void Search();
+	void Leave();
+	void FailJoin();
+	void RecordJoin(bool bWasSuccess);
+	void ScheduleSearch(float Delay);
+	void Schedule(float Delay, void (UGoLoadClient::*Step)());
+
+	UPROPERTY()
+	TObjectPtr<UGoSubsystem> GoSubsystem;
+	UPROPERTY()
+	TObjectPtr<UGameInstance> GameInstance;
+
+	EState State = EState::LoggingIn;
+	EGoLoadPattern Pattern = EGoLoadPattern::Fill;
+	int32 ClientId = 0;
+	FString HostAddress;
+	FString ReportFile;
+	double JoinStartTime = 0.0;
+	uint32 StepSerial = 0;
+};
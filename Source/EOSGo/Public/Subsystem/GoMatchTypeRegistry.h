@@ -0,0 +1,48 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GoMatchTypeRegistry.generated.h"
+class FOnlineSessionSettings;
+
+/**
+ * Config definition of a match type: its capacity and the extra attributes its sessions advertise.
+ */
+USTRUCT(BlueprintType)
+struct EOSGO_API FGoMatchTypeDefinition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EOS-Go|Session")
+	FName Name;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EOS-Go|Session", meta=(ClampMin="1"))
+	int32 MaxPlayers = 2;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EOS-Go|Session")
+	TMap<FName, FString> AdvertisedAttributes;
+};
+
+/**
+ * A registered match type with its session settings precomputed.
+ */
+struct EOSGO_API FGoMatchType
+{
+	FGoMatchTypeDefinition Definition;
+	//~ Settings every session of this type is created from; per-session values are set on a copy.
+	TSharedPtr<const FOnlineSessionSettings> SettingsTemplate;
+};
+
+/**
+ * Match types by name, built once from config.
+ */
+class EOSGO_API FGoMatchTypeRegistry
+{
+public:
+	void Build(const TArray<FGoMatchTypeDefinition>& Definitions);
+	const FGoMatchType* Find(FName MatchType) const { return MatchTypes.Find(MatchType); }
+
+	//~ Session settings shared by every match type, also used for unregistered ones.
+	static TSharedRef<FOnlineSessionSettings> MakeSettingsTemplate(FName MatchType, int32 MaxPlayers);
+
+private:
+	TMap<FName, FGoMatchType> MatchTypes;
+};
\ No newline at end of file
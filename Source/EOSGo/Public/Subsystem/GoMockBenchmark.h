@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Subsystem/GoOperationMetrics.h"
+#include "Subsystem/GoRequest.h"
+#include "UObject/Object.h"
+#include "GoMockBenchmark.generated.h"
+class UGoSubsystem;
+class AGoGameModeBase;
+
+/**
+ * Drives login, create, find, join, start, a register/unregister burst and destroy through the GoSubsystem and the
+ * authority AGoGameModeBase against the mock backend, then logs per-stage latency percentiles and process memory growth.
+ * Per-stage allocation counts come from a memory trace (-trace=default,memory): each stage is a timing region in Insights.
+ * A failed login, or a stage without an answer for 30 seconds, ends the run early.
+ * Started with "EOSGo.Mock.Benchmark [Iterations] [BurstSize] [-exit]" in a -EOSGoMock process (e.g. -game -nullrhi).
+ */
+UCLASS()
+class EOSGO_API UGoMockBenchmark : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static bool Start(UWorld* World, int32 Iterations, int32 BurstSize, bool bExitWhenDone);
+	static bool IsRunning() { return ActiveBenchmark != nullptr; }
+
+protected:
+	void OnLoginComplete(const FGoRequestResult& Result);
+	//~ Callbacks for the custom delegates on the GoSubsystem and the GoGameModeBase.
+	UFUNCTION()
+	void OnCreateSessionComplete(bool bWasSuccessful);
+	void OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful);
+	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	UFUNCTION()
+	void OnStartSessionComplete(bool bWasSuccessful);
+	void OnRegisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess);
+	void OnUnregisterPlayerResult(const FUniqueNetIdRef& PlayerId, bool bWasSuccess);
+	UFUNCTION()
+	void OnDestroySessionComplete(bool bWasSuccessful);
+
+private:
+	struct FStageStats
+	{
+		FGoLatencyHistogram Latency;
+		uint32 Failures = 0;
+		//~ Bytes, summed over the stage's runs.
+		int64 UsedPhysicalGrowth = 0;
+	};
+
+	void StartIteration();
+	static FString GetStageRegionName(EGoOnlineOperation Stage);
+	void BeginStage(EGoOnlineOperation Stage);
+	//~ Records the running stage; returns false if Stage isn't the one running (e.g. the destroy issued before a join).
+	bool EndStage(EGoOnlineOperation Stage, bool bWasSuccess);
+	bool CheckStageTimeout(float DeltaTime);
+	void StartJoin(const TArray<FOnlineSessionSearchResult>& SessionResults);
+	void StartRegisterBurst();
+	void StartUnregisterBurst();
+	void StartDestroy();
+	void Finish();
+
+	static UGoMockBenchmark* ActiveBenchmark;
+
+	UPROPERTY()
+	TObjectPtr<UGoSubsystem> GoSubsystem;
+	TWeakObjectPtr<AGoGameModeBase> GoGameModeBase;
+	FDelegateHandle FindSessionsHandle;
+	FDelegateHandle JoinSessionHandle;
+	FDelegateHandle RegisterPlayerResultHandle;
+	FDelegateHandle UnregisterPlayerResultHandle;
+	FTSTicker::FDelegateHandle StageTimeoutHandle;
+
+	FStageStats Stages[static_cast<int32>(EGoOnlineOperation::Count)];
+	EGoOnlineOperation RunningStage = EGoOnlineOperation::Count;
+	double StageStartTime = 0.0;
+	uint64 StageStartUsedPhysical = 0;
+
+	int32 IterationsLeft = 0;
+	int32 IterationsRun = 0;
+	int32 BurstSize = 0;
+	int32 BurstResultsLeft = 0;
+	bool bBurstSucceeded = true;
+	TArray<FUniqueNetIdRef> BurstPlayers;
+	bool bExitWhenDone = false;
+};
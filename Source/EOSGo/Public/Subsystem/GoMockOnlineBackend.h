@@ -0,0 +1,198 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Math/RandomStream.h"
+#include "OnlineSessionSettings.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "Subsystem/GoOperationMetrics.h"
+
+//~ The mock backend and everything that switches to it are development tools, compiled out of Shipping builds.
+#if !UE_BUILD_SHIPPING
+
+class FGoMockOnlineSession;
+class FGoMockOnlineIdentity;
+
+/**
+ * In-process stand-in for the EOS backend, enabled with -EOSGoMock (or EOSGo.Mock.Enabled=1 before the online interfaces are acquired).
+ * Every request completes asynchronously after EOSGo.Mock.LatencyMs (+/- EOSGo.Mock.LatencyJitterMs) and fails at EOSGo.Mock.FailureRate.
+ * Searches return the sessions hosted in this process plus EOSGo.Mock.RemoteSessions synthetic ones, in EOSGo.Mock.SearchBatches
+ * batches while the search is in progress. Game thread only.
+ * With -EOSGoReplay=File, latencies, outcomes and result counts come from a recorded trace instead (see FGoOnlineTraceReplay).
+ */
+class EOSGO_API FGoMockOnlineBackend
+{
+public:
+	static bool IsEnabled();
+	static FGoMockOnlineBackend& Get();
+
+	IOnlineSessionPtr GetSessionInterface() const;
+	IOnlineIdentityPtr GetIdentityInterface() const;
+
+	//~ Runs Completion once the simulated latency has passed, with the outcome of the failure rate roll or of the replayed trace.
+	//~ Operation picks the recorded completion to replay; Count for requests EOSGo doesn't time.
+	void Schedule(EGoOnlineOperation Operation, TFunction<void(bool bWasSuccess)>&& Completion);
+	//~ Runs Callback after DelaySeconds, without a failure roll or a replayed completion (e.g. the batches of a search).
+	void ScheduleAfter(double DelaySeconds, TFunction<void()>&& Callback);
+	//~ Detail recorded with the completion running now, when it was replayed.
+	const TOptional<int32>& GetReplayedDetail() const { return RunningDetail; }
+	//~ Drops every scheduled completion without running it.
+	void Reset();
+	int32 GetNumPending() const { return Pending.Num(); }
+
+	FRandomStream& GetRandom() { return Random; }
+
+private:
+	FGoMockOnlineBackend();
+	bool Tick(float DeltaTime);
+
+	struct FPendingCompletion
+	{
+		double DueTime = 0.0;
+		bool bWasSuccess = true;
+		TOptional<int32> ReplayedDetail;
+		TFunction<void(bool)> Completion;
+	};
+	void Insert(FPendingCompletion&& Entry);
+	//~ Sorted by DueTime; equal due times complete in request order.
+	TArray<FPendingCompletion> Pending;
+	TOptional<int32> RunningDetail;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FRandomStream Random;
+
+	TSharedPtr<FGoMockOnlineSession, ESPMode::ThreadSafe> Session;
+	TSharedPtr<FGoMockOnlineIdentity, ESPMode::ThreadSafe> Identity;
+};
+
+/**
+ * Session info of a mock session; resolves to a loopback address.
+ */
+class EOSGO_API FGoMockSessionInfo : public FOnlineSessionInfo
+{
+public:
+	FGoMockSessionInfo(const FUniqueNetIdRef& InSessionId, const FString& InConnectString)
+		: SessionId(InSessionId), ConnectString(InConnectString) {}
+
+	virtual const uint8* GetBytes() const override { return nullptr; }
+	virtual int32 GetSize() const override { return sizeof(FGoMockSessionInfo); }
+	virtual bool IsValid() const override { return SessionId->IsValid(); }
+	virtual const FUniqueNetId& GetSessionId() const override { return *SessionId; }
+	virtual FString ToString() const override { return SessionId->ToString(); }
+	virtual FString ToDebugString() const override { return FString::Printf(TEXT("MockSession %s (%s)"), *SessionId->ToString(), *ConnectString); }
+
+	FUniqueNetIdRef SessionId;
+	FString ConnectString;
+};
+
+/**
+ * IOnlineSession backed by FGoMockOnlineBackend. Only the calls EOSGo makes are simulated; the rest fail right away.
+ */
+class EOSGO_API FGoMockOnlineSession : public IOnlineSession
+{
+public:
+	virtual ~FGoMockOnlineSession() override = default;
+
+	virtual FUniqueNetIdPtr CreateSessionIdFromString(const FString& SessionIdStr) override;
+	virtual FNamedOnlineSession* GetNamedSession(FName SessionName) override;
+	virtual void RemoveNamedSession(FName SessionName) override;
+	virtual bool HasPresenceSession() override;
+	virtual EOnlineSessionState::Type GetSessionState(FName SessionName) const override;
+
+	virtual bool CreateSession(int32 HostingPlayerNum, FName SessionName, const FOnlineSessionSettings& NewSessionSettings) override;
+	virtual bool CreateSession(const FUniqueNetId& HostingPlayerId, FName SessionName, const FOnlineSessionSettings& NewSessionSettings) override;
+	virtual bool StartSession(FName SessionName) override;
+	virtual bool UpdateSession(FName SessionName, FOnlineSessionSettings& UpdatedSessionSettings, bool bShouldRefreshOnlineData = true) override;
+	virtual bool EndSession(FName SessionName) override;
+	virtual bool DestroySession(FName SessionName, const FOnDestroySessionCompleteDelegate& CompletionDelegate = FOnDestroySessionCompleteDelegate()) override;
+	virtual bool IsPlayerInSession(FName SessionName, const FUniqueNetId& UniqueId) override;
+
+	virtual bool StartMatchmaking(const TArray<FUniqueNetIdRef>& LocalPlayers, FName SessionName, const FOnlineSessionSettings& NewSessionSettings, TSharedRef<FOnlineSessionSearch>& SearchSettings) override { return false; }
+	virtual bool CancelMatchmaking(int32 SearchingPlayerNum, FName SessionName) override { return false; }
+	virtual bool CancelMatchmaking(const FUniqueNetId& SearchingPlayerId, FName SessionName) override { return false; }
+
+	virtual bool FindSessions(int32 SearchingPlayerNum, const TSharedRef<FOnlineSessionSearch>& SearchSettings) override;
+	virtual bool FindSessions(const FUniqueNetId& SearchingPlayerId, const TSharedRef<FOnlineSessionSearch>& SearchSettings) override;
+	virtual bool FindSessionById(const FUniqueNetId& SearchingUserId, const FUniqueNetId& SessionId, const FUniqueNetId& FriendId, const FOnSingleSessionResultCompleteDelegate& CompletionDelegate) override;
+	virtual bool CancelFindSessions() override;
+	virtual bool PingSearchResults(const FOnlineSessionSearchResult& SearchResult) override { return false; }
+
+	virtual bool JoinSession(int32 LocalUserNum, FName SessionName, const FOnlineSessionSearchResult& DesiredSession) override;
+	virtual bool JoinSession(const FUniqueNetId& LocalUserId, FName SessionName, const FOnlineSessionSearchResult& DesiredSession) override;
+
+	virtual bool FindFriendSession(int32 LocalUserNum, const FUniqueNetId& Friend) override { return false; }
+	virtual bool FindFriendSession(const FUniqueNetId& LocalUserId, const FUniqueNetId& Friend) override { return false; }
+	virtual bool FindFriendSession(const FUniqueNetId& LocalUserId, const TArray<FUniqueNetIdRef>& FriendList) override { return false; }
+	virtual bool SendSessionInviteToFriend(int32 LocalUserNum, FName SessionName, const FUniqueNetId& Friend) override { return false; }
+	virtual bool SendSessionInviteToFriend(const FUniqueNetId& LocalUserId, FName SessionName, const FUniqueNetId& Friend) override { return false; }
+	virtual bool SendSessionInviteToFriends(int32 LocalUserNum, FName SessionName, const TArray<FUniqueNetIdRef>& Friends) override { return false; }
+	virtual bool SendSessionInviteToFriends(const FUniqueNetId& LocalUserId, FName SessionName, const TArray<FUniqueNetIdRef>& Friends) override { return false; }
+
+	virtual bool GetResolvedConnectString(FName SessionName, FString& ConnectInfo, FName PortType = NAME_GamePort) override;
+	virtual bool GetResolvedConnectString(const FOnlineSessionSearchResult& SearchResult, FName PortType, FString& ConnectInfo) override;
+	virtual FOnlineSessionSettings* GetSessionSettings(FName SessionName) override;
+
+	virtual bool RegisterPlayer(FName SessionName, const FUniqueNetId& PlayerId, bool bWasInvited) override;
+	virtual bool RegisterPlayers(FName SessionName, const TArray<FUniqueNetIdRef>& Players, bool bWasInvited = false) override;
+	virtual bool UnregisterPlayer(FName SessionName, const FUniqueNetId& PlayerId) override;
+	virtual bool UnregisterPlayers(FName SessionName, const TArray<FUniqueNetIdRef>& Players) override;
+	virtual void RegisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnRegisterLocalPlayerCompleteDelegate& Delegate) override;
+	virtual void UnregisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnUnregisterLocalPlayerCompleteDelegate& Delegate) override;
+	virtual void RemovePlayerFromSession(int32 LocalUserNum, FName SessionName, const FUniqueNetId& TargetPlayerId) override {}
+
+	virtual int32 GetNumSessions() override { return Sessions.Num(); }
+	virtual void DumpSessionState() override;
+
+protected:
+	virtual FNamedOnlineSession* AddNamedSession(FName SessionName, const FOnlineSessionSettings& SessionSettings) override;
+	virtual FNamedOnlineSession* AddNamedSession(FName SessionName, const FOnlineSession& Session) override;
+
+private:
+	const FNamedOnlineSession* FindNamedSession(FName SessionName) const;
+	//~ Sessions hosted in this process and synthetic remote ones that match the search's Equals parameters.
+	//~ NumResults (when replaying) tops the results up to the recorded count instead of EOSGo.Mock.RemoteSessions.
+	void FillSearchResults(FOnlineSessionSearch& Search, const TOptional<int32>& NumResults);
+	//~ Fills the search's results up front and schedules their reveal in NumBatches steps; the last comes with the completion.
+	void StageSearchResults(const TSharedRef<FOnlineSessionSearch>& SearchSettings, int32 NumBatches);
+	void RevealStagedSearchResults(FOnlineSessionSearch& Search, int32 NumRevealed);
+	FUniqueNetIdRef MakeSessionId();
+
+	TArray<FNamedOnlineSession> Sessions;
+	TSharedPtr<FOnlineSessionSearch> CurrentSearch;
+	TArray<FOnlineSessionSearchResult> StagedSearchResults;
+	int32 NextSessionId = 1;
+};
+
+/**
+ * IOnlineIdentity backed by FGoMockOnlineBackend. Any credentials log in; ids are plain strings.
+ */
+class EOSGO_API FGoMockOnlineIdentity : public IOnlineIdentity
+{
+public:
+	virtual ~FGoMockOnlineIdentity() override = default;
+
+	virtual bool Login(int32 LocalUserNum, const FOnlineAccountCredentials& AccountCredentials) override;
+	virtual bool Logout(int32 LocalUserNum) override;
+	virtual bool AutoLogin(int32 LocalUserNum) override;
+	virtual TSharedPtr<FUserOnlineAccount> GetUserAccount(const FUniqueNetId& UserId) const override { return nullptr; }
+	virtual TArray<TSharedPtr<FUserOnlineAccount>> GetAllUserAccounts() const override { return {}; }
+	virtual FUniqueNetIdPtr GetUniquePlayerId(int32 LocalUserNum) const override;
+	virtual FUniqueNetIdPtr CreateUniquePlayerId(uint8* Bytes, int32 Size) override;
+	virtual FUniqueNetIdPtr CreateUniquePlayerId(const FString& Str) override;
+	virtual ELoginStatus::Type GetLoginStatus(int32 LocalUserNum) const override;
+	virtual ELoginStatus::Type GetLoginStatus(const FUniqueNetId& UserId) const override;
+	virtual FString GetPlayerNickname(int32 LocalUserNum) const override;
+	virtual FString GetPlayerNickname(const FUniqueNetId& UserId) const override;
+	virtual FString GetAuthToken(int32 LocalUserNum) const override { return FString(); }
+	virtual void RevokeAuthToken(const FUniqueNetId& LocalUserId, const FOnRevokeAuthTokenCompleteDelegate& Delegate) override;
+	virtual void GetUserPrivilege(const FUniqueNetId& LocalUserId, EUserPrivileges::Type Privilege, const FOnGetUserPrivilegeCompleteDelegate& Delegate, EShowPrivilegeResolveUI ShowResolveUI = EShowPrivilegeResolveUI::Default) override;
+	virtual FPlatformUserId GetPlatformUserIdFromUniqueNetId(const FUniqueNetId& UniqueNetId) const override;
+	virtual FString GetAuthType() const override { return TEXT("mock"); }
+
+private:
+	//~ Logged in users by local user number.
+	TMap<int32, FUniqueNetIdRef> LoggedInUsers;
+};
+
+#endif
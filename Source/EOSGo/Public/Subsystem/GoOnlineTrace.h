@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystem/GoOperationMetrics.h"
+
+enum class EGoOnlineTraceEventType : uint8
+{
+	Begin,
+	End,
+	Cancel
+};
+
+/**
+ * One request, completion or cancellation of an EOSGo online operation.
+ * Detail is a payload summary: players in a register/unregister request, results of a find, EOnJoinSessionCompleteResult of a join.
+ */
+struct EOSGO_API FGoOnlineTraceEvent
+{
+	double Time = 0.0;
+	uint32 Id = 0;
+	EGoOnlineTraceEventType Type = EGoOnlineTraceEventType::Begin;
+	EGoOnlineOperation Operation = EGoOnlineOperation::Count;
+	bool bWasSuccess = false;
+	int32 Detail = 0;
+};
+
+/**
+ * Compact binary trace of the operations timed by FGoOperationMetrics: a small header, then one record per event with
+ * varint-packed time deltas (us), ids and details. Started with -EOSGoRecord[=File] or "EOSGo.Trace.Record [File]", neither of which
+ * exists in Shipping builds. Game thread only.
+ */
+class EOSGO_API FGoOnlineTraceRecorder
+{
+public:
+	static FGoOnlineTraceRecorder& Get();
+
+	//~ An empty Filename writes Saved/EOSGo/Trace-<timestamp>.egotrace.
+	bool Start(const FString& Filename = FString());
+	void Stop();
+	bool IsRecording() const { return Writer.IsValid(); }
+
+	void Record(EGoOnlineTraceEventType Type, EGoOnlineOperation Operation, uint32 Id, bool bWasSuccess = false, int32 Detail = 0);
+
+	static bool Load(const FString& Filename, TArray<FGoOnlineTraceEvent>& OutEvents);
+	//~ Offline analysis: latency percentiles, failures and peak concurrency per operation.
+	static void Summarize(const TArray<FGoOnlineTraceEvent>& Events, FOutputDevice& Ar);
+
+private:
+	TUniquePtr<FArchive> Writer;
+	FString Filename;
+	double StartTime = 0.0;
+	uint64 LastTimeUs = 0;
+	uint32 NumEvents = 0;
+};
+
+//~ Replay drives the mock backend, so it is compiled out of Shipping builds with it.
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Completions of a recorded trace, fed to FGoMockOnlineBackend with -EOSGoReplay=File (which enables the mock).
+ * Each request takes the next recorded completion of its operation: its latency divided by EOSGo.Replay.Speed, its outcome and its detail.
+ * Requests past the end of the recording fall back to the EOSGo.Mock settings.
+ */
+class EOSGO_API FGoOnlineTraceReplay
+{
+public:
+	static FGoOnlineTraceReplay& Get();
+
+	bool Load(const FString& Filename);
+	bool IsActive() const { return bIsActive; }
+
+	struct FCompletion
+	{
+		double LatencySeconds = 0.0;
+		bool bWasSuccess = false;
+		int32 Detail = 0;
+	};
+	//~ Pops the next recorded completion of Operation; false when there is none left.
+	bool Take(EGoOnlineOperation Operation, FCompletion& OutCompletion);
+	void Rewind();
+
+private:
+	FGoOnlineTraceReplay();
+
+	static constexpr int32 NumOperations = static_cast<int32>(EGoOnlineOperation::Count);
+	TArray<FCompletion> Completions[NumOperations];
+	int32 NextCompletion[NumOperations] = {};
+	bool bIsActive = false;
+};
+
+#endif
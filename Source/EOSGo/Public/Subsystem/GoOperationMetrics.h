@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "GoOperationMetrics.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("EOSGo"), STATGROUP_EOSGo, STATCAT_Advanced);
+
+/**
+ * Asynchronous online operations timed from request to completion delegate.
+ */
+UENUM(BlueprintType)
+enum class EGoOnlineOperation : uint8
+{
+	Login,
+	Create,
+	Find,
+	Join,
+	Start,
+	Update,
+	Destroy,
+	RegisterPlayers,
+	UnregisterPlayers,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Latency histogram with fixed logarithmic buckets (~19% wide, 1 ms to ~65 s), so recording never allocates.
+ * Percentiles are accurate to one bucket width.
+ */
+struct EOSGO_API FGoLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 64;
+	static constexpr int32 BucketsPerOctave = 4;
+
+	void Add(double Milliseconds);
+	//~ Percentile in [0, 1]; returns 0 when nothing was recorded.
+	double GetPercentile(float Percentile) const;
+	void Reset();
+
+	uint64 Count = 0;
+	double MinMs = 0.0;
+	double MaxMs = 0.0;
+	double TotalMs = 0.0;
+
+private:
+	static int32 GetBucketIndex(double Milliseconds);
+	static double GetBucketUpperBound(int32 Index);
+
+	uint32 Buckets[NumBuckets] = {};
+};
+
+/**
+ * Process-wide timings of EOSGo online operations.
+ * Each operation feeds STATGROUP_EOSGo, begin/end events on the EOSGo trace channel and a latency histogram.
+ * Operations of the same type and Key (the named session they act on) complete in request order, so they are paired
+ * first in, first out per key; operations on different sessions may complete in any order. Game thread only.
+ * Detail is a payload summary kept only by FGoOnlineTraceRecorder (e.g. players in a request, results of a search).
+ */
+class EOSGO_API FGoOperationMetrics
+{
+public:
+	static FGoOperationMetrics& Get();
+
+	void Begin(EGoOnlineOperation Operation, int32 Detail = 0, FName Key = NAME_None);
+	void End(EGoOnlineOperation Operation, bool bWasSuccess, int32 Detail = 0, FName Key = NAME_None);
+	//~ Drops the latest Begin of the key without recording it (e.g. the operation was requeued).
+	void Cancel(EGoOnlineOperation Operation, FName Key = NAME_None);
+
+	const FGoLatencyHistogram& GetHistogram(EGoOnlineOperation Operation) const;
+	uint32 GetFailureCount(EGoOnlineOperation Operation) const;
+	void Dump(FOutputDevice& Ar) const;
+	void Reset();
+
+private:
+	struct FPendingOperation
+	{
+		uint32 Id = 0;
+		FName Key;
+		double StartTime = 0.0;
+	};
+
+	static constexpr int32 NumOperations = static_cast<int32>(EGoOnlineOperation::Count);
+	TArray<FPendingOperation, TInlineAllocator<4>> Pending[NumOperations];
+	FGoLatencyHistogram Histograms[NumOperations];
+	uint32 Failures[NumOperations] = {};
+	uint32 NextId = 1;
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+/**
+ * Outcome of one Go* request, delivered only to the callback it was issued with.
+ */
+struct EOSGO_API FGoRequestResult
+{
+	//~ Id the Go* call returned, unique per subsystem. Ids start at 1; 0 is never issued.
+	int32 RequestId = 0;
+	bool bWasSuccessful = false;
+	//~ Session the request acted on, None for logins and searches.
+	FName SessionName;
+	//~ Operation specific detail: the EOnJoinSessionCompleteResult of a join, the number of sessions a search found,
+	//~ whether a quick match hosted (1) or joined (0).
+	int32 Detail = 0;
+	//~ Completed by UGoSubsystem::CancelRequest (or the subsystem shutting down) instead of the operation.
+	bool bWasCancelled = false;
+};
+
+DECLARE_DELEGATE_OneParam(FGoOnRequestComplete, const FGoRequestResult& Result);
+DECLARE_DELEGATE_TwoParams(FGoOnFindSessionsRequestComplete, const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults);
+//~ Results a streaming search produced since its previous batch.
+DECLARE_DELEGATE_OneParam(FGoOnFindSessionsBatch, const TArray<FOnlineSessionSearchResult>& SessionResults);
+
+/**
+ * A request waiting for its operation to complete. Requests collapsed into one operation all receive its outcome.
+ */
+template <typename DelegateType>
+struct TGoRequest
+{
+	int32 RequestId = 0;
+	DelegateType OnComplete;
+
+	template <typename... ArgTypes>
+	void Complete(bool bWasSuccessful, FName SessionName, int32 Detail, ArgTypes&&... Args) const
+	{
+		OnComplete.ExecuteIfBound(FGoRequestResult{RequestId, bWasSuccessful, SessionName, Detail}, Forward<ArgTypes>(Args)...);
+	}
+	template <typename... ArgTypes>
+	void Cancel(FName SessionName, ArgTypes&&... Args) const
+	{
+		OnComplete.ExecuteIfBound(FGoRequestResult{RequestId, false, SessionName, 0, true}, Forward<ArgTypes>(Args)...);
+	}
+};
+using FGoRequest = TGoRequest<FGoOnRequestComplete>;
+using FGoFindSessionsRequest = TGoRequest<FGoOnFindSessionsRequestComplete>;
+
+//~ Removes a request from a list, returning whether it was there.
+template <typename DelegateType>
+bool TakeGoRequest(TArray<TGoRequest<DelegateType>>& Requests, int32 RequestId, TGoRequest<DelegateType>& OutRequest)
+{
+	const int32 Index = Requests.IndexOfByPredicate([RequestId](const TGoRequest<DelegateType>& Request) { return Request.RequestId == RequestId; });
+	if (Index == INDEX_NONE) return false;
+
+	OutRequest = MoveTemp(Requests[Index]);
+	Requests.RemoveAt(Index);
+	return true;
+}
+
+//~ Completes every request of a list. The list is taken first, so callbacks may issue new requests into it.
+template <typename DelegateType, typename... ArgTypes>
+void CompleteGoRequests(TArray<TGoRequest<DelegateType>>& Requests, bool bWasSuccessful, FName SessionName, int32 Detail, ArgTypes&&... Args)
+{
+	const TArray<TGoRequest<DelegateType>> Completed = MoveTemp(Requests);
+	Requests.Reset();
+	for (const TGoRequest<DelegateType>& Request : Completed)
+	{
+		Request.Complete(bWasSuccessful, SessionName, Detail, Args...);
+	}
+}
+
@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+#include <type_traits>
+
+/**
+ * Session attribute with a fixed value type, advertisement and a key interned once at startup.
+ * Settings and search params go through the same descriptor, so a value of another type is a compile error
+ * instead of a setting the search silently never matches.
+ */
+template <typename ValueType>
+struct TGoSessionAttribute
+{
+	static_assert(std::is_same_v<ValueType, int32> || std::is_same_v<ValueType, int64> || std::is_same_v<ValueType, bool>
+		|| std::is_same_v<ValueType, float> || std::is_same_v<ValueType, double> || std::is_same_v<ValueType, FString>,
+		"Session attributes hold the value types FVariantData advertises.");
+
+	explicit TGoSessionAttribute(const TCHAR* InName, EOnlineDataAdvertisementType::Type InAdvertisement = EOnlineDataAdvertisementType::ViaOnlineService)
+		: Name(InName), Advertisement(InAdvertisement) {}
+
+	template <typename ArgType>
+	void Set(FOnlineSessionSettings& Settings, const ArgType& Value) const
+	{
+		static_assert(std::is_same_v<ArgType, ValueType>, "Value type doesn't match the session attribute's.");
+		Settings.Set(Name, Value, Advertisement);
+	}
+	template <typename ArgType>
+	bool Get(const FOnlineSessionSettings& Settings, ArgType& OutValue) const
+	{
+		static_assert(std::is_same_v<ArgType, ValueType>, "Value type doesn't match the session attribute's.");
+		return Settings.Get(Name, OutValue);
+	}
+	template <typename ArgType>
+	void SetSearchParam(FOnlineSessionSearch& Search, const ArgType& Value, EOnlineComparisonOp::Type Comparison = EOnlineComparisonOp::Equals) const
+	{
+		static_assert(std::is_same_v<ArgType, ValueType>, "Value type doesn't match the session attribute's.");
+		Search.QuerySettings.Set(Name, Value, Comparison);
+	}
+
+	const FName Name;
+	const EOnlineDataAdvertisementType::Type Advertisement;
+};
+
+namespace EOSGo::SessionAttributes
+{
+	//~ Match type name (FGoMatchTypeDefinition::Name).
+	EOSGO_API extern const TGoSessionAttribute<FString> MatchType;
+	//~ Whether the session is only joinable through its join id.
+	EOSGO_API extern const TGoSessionAttribute<bool> IsPrivate;
+	//~ Join id of private sessions, 0 for public ones. int64 like the EOS attribute it's stored in.
+	EOSGO_API extern const TGoSessionAttribute<int64> ServerJoinId;
+	//~ Name the host created the session under, for servers hosting several named sessions.
+	EOSGO_API extern const TGoSessionAttribute<FString> HostSessionName;
+	//~ Port of the host's slot reservation beacon. Same key as SETTING_BEACONPORT, which GetResolvedConnectString reads for NAME_BeaconPort.
+	EOSGO_API extern const TGoSessionAttribute<int32> BeaconPort;
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystem/GoRequest.h"
+#include "GoSessionOperation.generated.h"
+class FOnlineSessionSettings;
+class FOnlineSessionSearchResult;
+
+//~ Lifecycle of the game session owned by the UGoSubsystem.
+UENUM(BlueprintType)
+enum class EGoSessionState : uint8
+{
+	None,
+	Creating,
+	Joining,
+	Pending,
+	Starting,
+	InProgress,
+	Destroying
+};
+
+enum class EGoSessionOperationType : uint8
+{
+	Create,
+	Update,
+	Start,
+	Join,
+	Destroy
+};
+
+/**
+ * A queued session operation and the parameters it will be issued with.
+ */
+struct EOSGO_API FGoSessionOperation
+{
+	EGoSessionOperationType Type = EGoSessionOperationType::Create;
+	//~ Operations on different named sessions are independent of each other.
+	FName SessionName = NAME_GameSession;
+
+	//~ Create
+	int32 NumberOfConnections = 0;
+	FName MatchType;
+	int32 ServerPrivateJoinId = 0;
+	bool bIsPrivateSession = false;
+	bool bIsDedicated = false;
+
+	//~ Update
+	TSharedPtr<FOnlineSessionSettings> UpdateSettings;
+
+	//~ Join
+	TSharedPtr<FOnlineSessionSearchResult> SearchResult;
+	//~ Ranked runners-up joined in turn if this join fails, best first. They belong to this operation's requests.
+	TArray<TSharedPtr<FOnlineSessionSearchResult>> FailoverCandidates;
+
+	//~ Create or Join requeued behind a Destroy of its session. If the session is still there when it runs again, the
+	//~ Destroy failed and the operation fails too, instead of queueing another Destroy.
+	bool bIsAfterDestroy = false;
+
+	//~ Requests completed with the operation's outcome, including those of operations collapsed into it.
+	TArray<FGoRequest> Requests;
+
+	//~ True for operations that create, replace or remove the session itself.
+	bool ChangesSessionLifecycle() const;
+
+	//~ Whether two operations may be in flight at the same time.
+	bool ConflictsWith(EGoSessionOperationType OtherType) const;
+};
+
+//~ An operation issued to the backend that hasn't completed yet.
+struct FGoInFlightSessionOperation
+{
+	FName SessionName;
+	EGoSessionOperationType Type = EGoSessionOperationType::Create;
+	TArray<FGoRequest> Requests;
+	TArray<TSharedPtr<FOnlineSessionSearchResult>> FailoverCandidates;
+
+	bool operator==(const FGoInFlightSessionOperation& Other) const { return SessionName == Other.SessionName && Type == Other.Type; }
+};
+
+/**
+ * FIFO of session operations per named session. Redundant operations are collapsed on enqueue, and each session's
+ * front operation is released only while it doesn't conflict with that session's operations already in flight.
+ */
+class EOSGO_API FGoSessionOperationQueue
+{
+public:
+	//~ Returns false if the operation was merged into one already queued.
+	bool Enqueue(FGoSessionOperation&& Operation);
+	void PushFront(FGoSessionOperation&& Operation);
+	//~ Pops the oldest operation that doesn't conflict with an in-flight operation on its session.
+	bool PopReady(const TArray<FGoInFlightSessionOperation>& InFlight, FGoSessionOperation& OutOperation);
+	bool Contains(EGoSessionOperationType Type, FName SessionName = NAME_GameSession) const;
+	TArray<FGoRequest> TakeAllRequests();
+	//~ Takes a request out of its queued operation, dropping the operation once it has no request left.
+	bool TakeRequest(int32 RequestId, FGoRequest& OutRequest, FName& OutSessionName);
+	bool IsEmpty() const { return Operations.IsEmpty(); }
+
+private:
+	TArray<FGoSessionOperation> Operations;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+class FOnlineSessionSearch;
+
+/**
+ * Parameters a session search is filtered by.
+ * Searches with equal queries share cached results and in-flight requests.
+ */
+struct EOSGO_API FGoSessionSearchQuery
+{
+	int64 ServerJoinId = 0;
+	FName MatchType;
+
+	bool operator==(const FGoSessionSearchQuery& Other) const
+	{
+		return ServerJoinId == Other.ServerJoinId && MatchType == Other.MatchType;
+	}
+	friend uint32 GetTypeHash(const FGoSessionSearchQuery& Query)
+	{
+		return HashCombine(GetTypeHash(Query.ServerJoinId), GetTypeHash(Query.MatchType));
+	}
+};
+
+/**
+ * Completed session searches, kept for a time-to-live so repeated queries skip the backend.
+ */
+class EOSGO_API FGoSessionSearchCache
+{
+public:
+	//~ Returns the cached search for this query, or null if there is none or it is older than TimeToLive.
+	TSharedPtr<FOnlineSessionSearch> Find(const FGoSessionSearchQuery& Query, float TimeToLive);
+	void Add(const FGoSessionSearchQuery& Query, const TSharedRef<FOnlineSessionSearch>& Search);
+	void Invalidate();
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<FOnlineSessionSearch> Search;
+		double CompletedTime = 0.0;
+	};
+	TMap<FGoSessionSearchQuery, FEntry> Entries;
+};
\ No newline at end of file
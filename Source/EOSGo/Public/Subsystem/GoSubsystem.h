@@ -7,7 +7,16 @@
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Interfaces/OnlineUserInterface.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Subsystem/GoSessionSearchCache.h"
+#include "Subsystem/GoSessionOperation.h"
+#include "Subsystem/GoMatchTypeRegistry.h"
+#include "Subsystem/GoOperationMetrics.h"
+#include "Containers/Ticker.h"
+#include "Engine/TimerHandle.h"
+#include "UObject/UObjectGlobals.h"
 #include "GoSubsystem.generated.h"
+class AGoReservationBeaconClient;
+enum class EGoSlotReservationResult : uint8;
 
 //~ GO SUBSYSTEM DELEGATES
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGoOnLoginComplete, FName, Username);
@@ -17,22 +26,121 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FGoOnFindSessionsComplete, const TArray<FOn
 DECLARE_MULTICAST_DELEGATE_TwoParams(FGoOnJoinSessionComplete, FName SessionName, EOnJoinSessionCompleteResult::Type Result);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGoOnDestroySessionComplete, bool, bWasSuccessful);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGoOnStartSessionComplete, bool, bWasSuccessful);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGoOnQuickMatchComplete, bool, bWasSuccessful, bool, bIsHost);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FGoOnSessionOperationComplete, FName SessionName, EGoSessionOperationType Type, bool bWasSuccessful);
+
+enum class EGoQuickMatchStage : uint8
+{
+	None,
+	Searching,
+	Joining,
+	Hosting
+};
+
+//~ What the subsystem tracks for each named session it created or joined.
+struct FGoNamedSession
+{
+	EGoSessionState State = EGoSessionState::None;
+	EGoSessionState StateBeforeDestroy = EGoSessionState::None;
+	FName MatchType;
+	//~ Slot the host reserved for this client before it joined, passed on travel.
+	FString ReservationToken;
+};
+
+//~ Join waiting for the host's answer to a slot reservation.
+struct FGoPendingSlotReservation
+{
+	FGoSessionOperation Operation;
+	TWeakObjectPtr<AGoReservationBeaconClient> Beacon;
+};
+
+//~ Progress of the GoQuickMatch pipeline.
+struct FGoQuickMatch
+{
+	EGoQuickMatchStage Stage = EGoQuickMatchStage::None;
+	FName MatchType;
+	//~ The pipeline's own search, create and join; only their answers move it on. 0 when none is in flight.
+	int32 SearchRequestId = 0;
+	int32 CreateRequestId = 0;
+	int32 JoinRequestId = 0;
+	bool bHasHosted = false;
+	bool bDeadlinePassed = false;
+	FTimerHandle DeadlineTimerHandle;
+	FTimerHandle RetryTimerHandle;
+	TArray<FGoRequest> Requests;
+};
+
+//~ Search request waiting for the search of its query, in flight or queued.
+struct FGoPendingFindSessionsRequest
+{
+	FGoSessionSearchQuery Query;
+	FGoFindSessionsRequest Request;
+};
+
+//~ Search results held back from their requests: cached results until the next tick, completed searches for the display time.
+struct FGoDeferredFindSessionsResults
+{
+	TSharedPtr<FOnlineSessionSearch> Search;
+	bool bWasSuccessful = false;
+	double DeliveryTime = 0.0;
+	TArray<FGoFindSessionsRequest> Requests;
+	//~ Set for cached results of find-and-join requests: the streaming requests of the query take them as their final batch.
+	TOptional<FGoSessionSearchQuery> StreamingQuery;
+};
+
+//~ Whether a search result is good enough to join without waiting for the rest of the search.
+using FGoSessionSearchPredicate = TFunction<bool(const FOnlineSessionSearchResult& SearchResult)>;
+
+//~ Find-and-join request streaming the results of its query's search until one satisfies its predicate.
+struct FGoStreamingSearchRequest
+{
+	FGoSessionSearchQuery Query;
+	FGoRequest Request;
+	FGoSessionSearchPredicate JoinPredicate;
+	FGoOnFindSessionsBatch OnBatch;
+	//~ Results of the search already delivered in a batch.
+	int32 NumDelivered = 0;
+};
 
 /**
  * 
  */
-UCLASS()
+UCLASS(Config=Game)
 class EOSGO_API UGoSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
 public:
 	UGoSubsystem();
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//~ Every Go* call returns a request id and takes a callback that receives that request's outcome only (FGoRequestResult),
+	//~ next to the Go*Complete delegates. The callback may run before the call returns, e.g. when the request can't be issued.
+	//~ GoTasks.h wraps the calls as UE::Tasks tasks, GoAsyncActions.h as Blueprint async nodes.
+
+	//~ Completes the request right away with bWasCancelled. An operation that wasn't issued yet is dropped once none of its
+	//~ requests remain (a quick match stops, a queued search isn't started); one already issued still runs to completion.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	bool CancelRequest(int32 RequestId);
 
 	//~ To handle EOS login functionality.
-	void GoEOSLogin(FString Id, FString Token, FString LoginType);
+	int32 GoEOSLogin(const FString& Id, const FString& Token, const FString& LoginType, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Account")
 	FGoOnLoginComplete GoOnLoginComplete;
+	//~ Silent login with command line credentials or the stored refresh token (persistentauth). Runs on Initialize when bAutoLoginOnStartup is set.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Account")
+	int32 GoAutoLogin();
+	int32 GoAutoLogin(FGoOnRequestComplete OnComplete);
+	//~ Login requested by the player: reuses a finished or running background login, otherwise opens the account portal.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Account")
+	int32 GoInteractiveLogin();
+	int32 GoInteractiveLogin(FGoOnRequestComplete OnComplete);
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Account")
+	bool IsLoginInProgress() const { return bIsLoginInProgress; }
+
+	UPROPERTY(Config, EditAnywhere, Category="EOS-Go|Account")
+	bool bAutoLoginOnStartup = true;
 	
 	UFUNCTION(BlueprintPure, Category="EOS-Go|Account")
 	bool IsPlayerLoggedIn();
@@ -41,33 +149,211 @@ public:
 
 	
 	//~ To handle session functionality.
-	void GoCreateSession(int32 NumberOfConnections, FString MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession);
+	//~ Create, Update, Start, Join and Destroy are queued and issued in order per named session; redundant requests are collapsed.
+	//~ Players create, join and travel with NAME_GameSession, the only session the Go*Complete delegates report.
+	//~ Servers can host more named sessions at once (e.g. GoHostDedicatedLobby), each advertised, registered and started on its own.
+	//~ Requests collapsed into one queued operation all receive its outcome.
+	int32 GoCreateSession(int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId, bool bIsPrivateSession, FName SessionName = NAME_GameSession,
+		FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	FGoOnCreateSessionComplete GoOnCreateSessionComplete;
-	void UpdateSession(FOnlineSessionSettings& UpdateSessionSettings);
+	//~ Dedicated servers host without a player: the session is created under the server's identity (EOS authenticates it with
+	//~ the product's client credentials, no login), advertised without presence, and players are registered as they arrive.
+	//~ NumberOfConnections is only used for match types that aren't registered. Completes through GoOnCreateSessionComplete.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	int32 GoHostDedicatedSession(FName MatchType, int32 NumberOfConnections = 0);
+	int32 GoHostDedicatedSession(FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete OnComplete);
+	//~ Hosts one more dedicated session next to the others in this process and returns its name ("GoLobby_<N>").
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	FName GoHostDedicatedLobby(FName MatchType, int32 NumberOfConnections = 0);
+	int32 GoHostDedicatedLobby(FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete OnComplete, FName& OutSessionName);
+	int32 UpdateSession(const FOnlineSessionSettings& UpdateSessionSettings, FName SessionName = NAME_GameSession, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	FGoOnUpdateSessionComplete GoOnUpdateSessionComplete;
-	void GoFindSessions(int64 InServerJoinId);
+	//~ Requests for the same query share its search; the result's Detail is the number of sessions found.
+	int32 GoFindSessions(int64 InServerJoinId, FName MatchType = NAME_None, FGoOnFindSessionsRequestComplete OnComplete = FGoOnFindSessionsRequestComplete());
 	FGoOnFindSessionsComplete GoOnFindSessionsComplete;
-	void GoJoinSession(const FOnlineSessionSearchResult& SessionSearchResult);
+	//~ Streams the search's results in batches as the backend produces them and joins from the first batch with results JoinPredicate
+	//~ accepts (MakeJoinPredicate(MatchType) when unset), so the join doesn't wait for the slowest part of a large query. That batch's
+	//~ accepted results are ranked as by GoJoinBestSession: the best is joined and the others are its failover candidates. The rest of
+	//~ the search is cancelled unless other requests share it. The result is the join's; SessionDoesNotExist when nothing was accepted.
+	int32 GoFindAndJoinSession(int64 InServerJoinId, FName MatchType = NAME_None, FGoSessionSearchPredicate JoinPredicate = FGoSessionSearchPredicate(),
+		FGoOnFindSessionsBatch OnBatch = FGoOnFindSessionsBatch(), FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
+	//~ Accepts sessions of MatchType (any type when None) with at least MinOpenSlots open public connections.
+	static FGoSessionSearchPredicate MakeJoinPredicate(FName MatchType = NAME_None, int32 MinOpenSlots = 1);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	void InvalidateSessionSearchCache();
+	//~ The result's Detail is the EOnJoinSessionCompleteResult.
+	int32 GoJoinSession(const FOnlineSessionSearchResult& SessionSearchResult, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	FGoOnJoinSessionComplete GoOnJoinSessionComplete;
-	void GoDestroySession();
+	//~ Joins the best ranked result; failed joins fail over to the next candidate without a new search.
+	//~ GoOnJoinSessionComplete fires once, on success or when every candidate failed.
+	int32 GoJoinBestSession(const TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType = NAME_None, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
+	//~ Sorts results best first by match type, ping and open public connections, dropping full sessions.
+	static void RankJoinCandidates(TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType = NAME_None);
+	//~ Looks the session up by the id the code encodes (FGoJoinCode), without a search, and joins it.
+	//~ GoOnJoinSessionComplete reports SessionDoesNotExist for malformed codes and sessions that are gone.
+	//~ Several codes may be looked up at once; each lookup answers its own request.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	int32 GoJoinSessionByCode(const FString& JoinCode);
+	int32 GoJoinSessionByCode(const FString& JoinCode, FGoOnRequestComplete OnComplete);
+	//~ Code other players join this session with. Unique while the session exists; empty without one.
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	FString GetJoinCode() const { return GetNamedSessionJoinCode(NAME_GameSession); }
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	FString GetNamedSessionJoinCode(FName SessionName) const;
+	//~ Address to travel to after joining, with the host's session name as the GoSession option when it isn't its game session
+	//~ and the slot reservation token as the GoReservation option.
+	bool GetJoinedSessionTravelUrl(FString& OutUrl) const;
+	int32 GoDestroySession(FName SessionName = NAME_GameSession, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	FGoOnDestroySessionComplete GoOnDestroySessionComplete;
-	void GoStartSession();
+	int32 GoStartSession(FName SessionName = NAME_GameSession, FGoOnRequestComplete OnComplete = FGoOnRequestComplete());
 	FGoOnStartSessionComplete GoOnStartSessionComplete;
+	//~ Every completed backend operation, on any named session (a failed-over join reports each attempt).
+	FGoOnSessionOperationComplete GoOnSessionOperationComplete;
+
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	EGoSessionState GetSessionState() const { return GetNamedSessionState(NAME_GameSession); }
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	EGoSessionState GetNamedSessionState(FName SessionName) const;
+	//~ Named sessions that currently exist or are being created or joined.
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	TArray<FName> GetSessionNames() const;
+
+	//~ To handle quick match: search, join the best session with open slots, or host if none shows up before the deadline.
+	//~ With bSpeculativeHost a session is hosted while searching; whichever path loses is cancelled. A quick match that fails or is
+	//~ cancelled (CancelRequest) leaves the session it hosted or was joining.
+	//~ The result's Detail is 1 when the quick match hosted, 0 when it joined.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Session")
+	int32 GoQuickMatch(FName MatchType, bool bSpeculativeHost = false);
+	int32 GoQuickMatch(FName MatchType, bool bSpeculativeHost, FGoOnRequestComplete OnComplete);
+	UPROPERTY(BlueprintAssignable, Category="EOS-Go|Session")
+	FGoOnQuickMatchComplete GoOnQuickMatchComplete;
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	bool IsQuickMatchInProgress() const { return QuickMatch.Stage != EGoQuickMatchStage::None; }
+
+	//~ Time (seconds) GoQuickMatch searches for a session to join before hosting one.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session")
+	float QuickMatchSearchDeadline = 5.f;
+	//~ Time (seconds) between GoQuickMatch searches that found nothing to join.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session")
+	float QuickMatchRetryInterval = 1.f;
+
+	//~ To handle match types.
+	const FGoMatchType* FindMatchType(FName MatchType) const { return MatchTypeRegistry.Find(MatchType); }
+	//~ Match type of a session created by this subsystem, or null if there is none or it isn't registered.
+	const FGoMatchType* GetCurrentMatchType(FName SessionName = NAME_GameSession) const;
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	bool GetMatchTypeDefinition(FName MatchType, FGoMatchTypeDefinition& OutDefinition) const;
+
+	//~ Match types sessions can be created and searched with. Each one's settings are precomputed on Initialize.
+	UPROPERTY(Config, EditAnywhere, Category="EOS-Go|Session")
+	TArray<FGoMatchTypeDefinition> MatchTypes;
 
 	UPROPERTY(BlueprintReadWrite)
-	int32 ServerJoinId = 0;	//~ Server Join Id displayed on the UI.
+	int32 ServerJoinId = 0;	//~ Server Join Id of private sessions, for search-based joins. The UI shows GetJoinCode, which is collision free.
+
+	//~ Minimum time (seconds) between GoFindSessions and its broadcast, for UIs that want to display a searching state. 0 broadcasts on completion.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session")
+	float MinFindSessionsDisplayTime = 0.f;
+
+	//~ How long (seconds) completed search results are reused for identical queries. 0 disables the cache.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session")
+	float FindSessionsCacheTimeToLive = 5.f;
+
+	//~ Whether joins first ask hosts that advertise a reservation beacon for a slot (AGoReservationBeaconClient).
+	//~ A full host turns the join down before the backend join and travel, so ranked joins fail over right away.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session")
+	bool bReserveSlotBeforeJoin = true;
+	//~ Advertises the server's reservation beacon port with every session it hosts (0 for none). Set by AGoGameModeBase.
+	void SetReservationBeaconPort(int32 Port);
+
+	//~ Most candidates GoJoinBestSession tries before giving up.
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category="EOS-Go|Session", meta=(ClampMin="1"))
+	int32 MaxJoinAttempts = 3;
+
+	//~ Time (seconds) from the last GoFindSessions call until its results were broadcast.
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Session")
+	float GetLastFindSessionsTimeToResults() const { return LastFindSessionsTimeToResults; }
+
+	//~ To handle map preloading: loads a travel destination (e.g. "/EOSGo/Maps/LobbyMap?listen") and its dependencies in the background
+	//~ while a session is created or joined, so the travel finds them resident. Held until the next map load or ReleasePreloadedMap.
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Travel")
+	void PreloadMap(const FString& MapUrl);
+	UFUNCTION(BlueprintCallable, Category="EOS-Go|Travel")
+	void ReleasePreloadedMap();
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Travel")
+	bool IsMapPreloaded() const { return PreloadedWorld != nullptr; }
+
+	//~ Request-to-completion latency in ms at a percentile in [0, 1] (e.g. 0.95), across all EOSGo users in this process.
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Metrics")
+	float GetOperationLatencyPercentile(EGoOnlineOperation Operation, float Percentile) const;
+	UFUNCTION(BlueprintPure, Category="EOS-Go|Metrics")
+	int32 GetOperationCount(EGoOnlineOperation Operation) const;
 	
 protected:
 	//~ To handle Login functionality.
 	void OnLoginComplete(int32 LocalUserNum, bool bWasSuccess, const FUniqueNetId& UserId, const FString& Error);
+	void StartLogin(const FString& Id, const FString& Token, const FString& LoginType, FGoRequest&& Request);
+	void CompleteLoginRequests(bool bWasSuccess);
+	//~ Gives every pending request its answer when the subsystem goes away.
+	void CancelAllRequests();
+	static bool GetCommandLineCredentials(FString& OutId, FString& OutToken, FString& OutLoginType);
+	int32 GetLocalUserNum() const;
+	FUniqueNetIdPtr GetLocalUserId() const;
 	
 	//~ To handle session functionality.
 	void OnCreateSessionComplete(FName SessionName, bool bWasSuccess);
 	void OnUpdateSessionComplete(FName SessionName, bool bWasSuccess);
 	void OnFindSessionsComplete(bool bWasSuccess);
+	void BroadcastFindSessionsResults(TSharedPtr<FOnlineSessionSearch> Search, bool bWasSuccess, TArray<FGoFindSessionsRequest> Requests);
+	//~ Delivers the results on a later tick, never from inside the Go* call. CancelRequest and CancelAllRequests reach the held requests.
+	void DeferFindSessionsResults(FGoDeferredFindSessionsResults&& Deferred);
+	bool TickDeferredFindSessionsResults(float DeltaTime);
+	TArray<FGoFindSessionsRequest> TakeFindSessionsRequests(const FGoSessionSearchQuery& Query);
+	bool StartFindSessions(const FGoSessionSearchQuery& Query);
+	void StartNextPendingFindSessions();
+	//~ Answers every request of a search that couldn't be started.
+	void FailFindSessions(const FGoSessionSearchQuery& Query);
+	//~ Streams the results each request of the query hasn't seen yet. Requests whose predicate accepts one leave to join it.
+	void StreamSearchResults(const FGoSessionSearchQuery& Query, const TArray<FOnlineSessionSearchResult>& SessionResults);
+	//~ Streams the last batch, then answers the query's requests that accepted nothing.
+	void FinishStreamingSearches(const FGoSessionSearchQuery& Query, const TArray<FOnlineSessionSearchResult>& SessionResults);
+	bool TakeStreamingSearchRequest(int32 RequestId, FGoStreamingSearchRequest& OutRequest);
+	bool HasStreamingSearchRequests(const FGoSessionSearchQuery& Query) const;
+	//~ Polls the in-flight search for results while streaming requests wait on it.
+	void UpdateSearchStreaming();
+	bool TickSearchStreaming(float DeltaTime);
+	//~ Stops the in-flight search once nobody waits for the rest of its results, and starts the next queued one.
+	void CancelFindSessionsIfUnwanted();
 	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void OnFindSessionByIdComplete(int32 LocalUserNum, bool bWasSuccess, const FOnlineSessionSearchResult& SearchResult, int32 RequestId);
 	void OnDestroySessionComplete(FName SessionName, bool bWasSuccess);
 	void OnStartSessionComplete(FName SessionName,bool bWasSuccess);
+
+	//~ To handle the session operation queue.
+	void EnqueueSessionOperation(FGoSessionOperation&& Operation);
+	//~ Enqueues the operation with a new request, or fails the request right away without a session interface.
+	int32 RequestSessionOperation(FGoSessionOperation&& Operation, FGoOnRequestComplete&& OnComplete);
+	void RequestSessionOperation(FGoSessionOperation&& Operation, FGoRequest&& Request);
+	void ProcessSessionOperations();
+	//~ Detail goes to the online trace (e.g. the EOnJoinSessionCompleteResult of a join).
+	//~ Completes the operation's requests with the same Detail.
+	void FinishSessionOperation(FName SessionName, EGoSessionOperationType Type, bool bWasSuccess, int32 Detail = 0);
+	TArray<FGoRequest> TakeInFlightRequests(FName SessionName, EGoSessionOperationType Type);
+	bool IsSessionOperationInFlight(FName SessionName, EGoSessionOperationType Type) const { return InFlightSessionOperations.Contains({SessionName, Type}); }
+	//~ Session interface delegates stay bound while any operation of their type is in flight, whatever its session.
+	int32 GetNumInFlightSessionOperations(EGoSessionOperationType Type) const;
+	static EGoOnlineOperation GetOnlineOperation(EGoSessionOperationType Type);
+	//~ Requeues a Create or Join behind a Destroy of its session, or fails it if that Destroy already ran and failed.
+	void DestroyBeforeSessionOperation(FGoSessionOperation&& Operation);
+	void ExecuteCreateSession(FGoSessionOperation&& Operation);
+	void ExecuteUpdateSession(FGoSessionOperation&& Operation);
+	void ExecuteJoinSession(FGoSessionOperation&& Operation);
+	void StartJoinSession(FGoSessionOperation&& Operation);
+	//~ Takes the operation and returns true if a reservation was requested; it resumes in OnSlotReservationComplete.
+	bool RequestSlotReservation(FGoSessionOperation& Operation);
+	void OnSlotReservationComplete(EGoSlotReservationResult Result, const FString& Token, FName SessionName);
+	void ExecuteDestroySession(FGoSessionOperation&& Operation);
+	void ExecuteStartSession(FGoSessionOperation&& Operation);
 	
 private:
 	IOnlineIdentityPtr Identity;
@@ -76,6 +362,18 @@ private:
 	TSharedPtr<FOnlineUser> User;
 	TSharedPtr<FOnlineSessionSearch> SessionSearchSettings;
 
+	//~ OnFindSessions utils
+	FGoSessionSearchCache SessionSearchCache;
+	TOptional<FGoSessionSearchQuery> InFlightSearchQuery;
+	TArray<FGoSessionSearchQuery> PendingSearchQueries;
+	TArray<FGoPendingFindSessionsRequest> PendingFindSessionsRequests;
+	TArray<FGoStreamingSearchRequest> StreamingSearchRequests;
+	FTSTicker::FDelegateHandle SearchStreamingTickerHandle;
+	TArray<FGoDeferredFindSessionsResults> DeferredFindSessionsResults;
+	FTSTicker::FDelegateHandle DeferredFindSessionsTickerHandle;
+	double FindSessionsStartTime = 0.0;
+	float LastFindSessionsTimeToResults = 0.f;
+
 	//~ Delegates to add to the Online Session Interface delegate list. Each one has its own handle.
 	FOnLoginCompleteDelegate LoginCompleteDelegate;
 	FDelegateHandle LoginCompleteDelegateHandle;
@@ -92,13 +390,67 @@ private:
 	FOnStartSessionCompleteDelegate StartSessionCompleteDelegate;
 	FDelegateHandle StartSessionCompleteDelegateHandle;
 
-	//~ OnDestroySession utils
-	bool bCreateSessionOnDestroy {false};
-	bool bCreatePrivateSession {false};
-	int32 LastNumberOfPublicConnections = 0;
-	int64 LastServerPrivateJoinId = 0;
-	FString LastMatchType {FString()};
+	//~ Session state machine, per named session
+	TMap<FName, FGoNamedSession> NamedSessions;
+	FGoSessionOperationQueue SessionOperations;
+	TArray<FGoInFlightSessionOperation> InFlightSessionOperations;
+	int32 NextDedicatedLobbyIndex = 0;
+
+	//~ OnJoinSession utils - join code lookups in flight by request id, and the requests still waiting for theirs.
+	TArray<int32> FindSessionByIdLookups;
+	TArray<FGoRequest> FindSessionByIdRequests;
+	TMap<FName, FGoPendingSlotReservation> PendingSlotReservations;
+	int32 ReservationBeaconPort = 0;
+	void JoinSession(const FOnlineSessionSearchResult& SessionSearchResult, FGoRequest&& Request);
+	//~ Joins the first of the ranked candidates, keeping up to MaxJoinAttempts - 1 of the others for failover.
+	void JoinRankedCandidates(TArray<FOnlineSessionSearchResult>&& Candidates, FGoRequest&& Request);
+	//~ Joins the first candidate; the others are failed over to, in order, with the same requests.
+	void EnqueueJoinSession(TArray<TSharedPtr<FOnlineSessionSearchResult>>&& Candidates, TArray<FGoRequest>&& Requests);
+	void BroadcastJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void BroadcastCreateSessionComplete(FName SessionName, bool bWasSuccess);
+	void FindSessions(const FGoSessionSearchQuery& Query, FGoFindSessionsRequest&& Request);
+	int32 HostDedicatedSession(FName SessionName, FName MatchType, int32 NumberOfConnections, FGoOnRequestComplete&& OnComplete);
+
+	//~ Quick match
+	FGoQuickMatch QuickMatch;
+	void StartQuickMatchSearch();
+	void StartQuickMatchHosting();
+	void OnQuickMatchSearchComplete(const FGoRequestResult& Result, const TArray<FOnlineSessionSearchResult>& SessionResults);
+	void OnQuickMatchJoinComplete(const FGoRequestResult& Result);
+	void OnQuickMatchCreateComplete(const FGoRequestResult& Result);
+	void OnQuickMatchDeadline();
+	void CancelQuickMatchRequest(int32& RequestId);
+	void FinishQuickMatch(bool bWasSuccess, bool bIsHost);
+
+	//~ Map preloading
+	void OnMapPreloaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	FName PreloadingMapPackage;
+	UPROPERTY()
+	TObjectPtr<UWorld> PreloadedWorld;
+	FDelegateHandle PostLoadMapHandle;
+
+	//~ Match types
+	FGoMatchTypeRegistry MatchTypeRegistry;
 	
+	//~ Login state
+	bool bIsLoginInProgress = false;
+	bool bIsBackgroundLogin = false;
+	bool bInteractiveLoginRequested = false;
+	//~ A failed background login only fails its own requests; the player's requests wait for the account portal login.
+	TArray<FGoRequest> BackgroundLoginRequests;
+	TArray<FGoRequest> LoginRequests;
+
+	//~ Requests
+	int32 LastRequestId = 0;
+	template <typename DelegateType>
+	TGoRequest<DelegateType> MakeRequest(DelegateType OnComplete)
+	{
+		//~ Ids wrap around to 1; 0 is never issued.
+		LastRequestId = LastRequestId == MAX_int32 ? 1 : LastRequestId + 1;
+		return TGoRequest<DelegateType>{LastRequestId, MoveTemp(OnComplete)};
+	}
+
 	//~ Persistent Data
 	UPROPERTY(BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
 	FName LoggedPlayerUsername{"Unknown"};
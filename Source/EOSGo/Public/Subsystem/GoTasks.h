@@ -0,0 +1,55 @@
+// Copyright (c) 2024 Fedahumada Studio. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Subsystem/GoSubsystem.h"
+
+//~ Outcome of a find sessions task.
+struct EOSGO_API FGoFindSessionsResult
+{
+	FGoRequestResult Request;
+	TArray<FOnlineSessionSearchResult> SessionResults;
+};
+
+/**
+ * A Go* request as a UE::Tasks task, completed on the game thread with the request's result.
+ * Chain steps with UE::Tasks::Launch(..., UE::Tasks::Prerequisites(Task.Task)) or wait for several at once; never Wait() on
+ * the game thread, which is the thread requests complete on. The task always completes: if the request is dropped
+ * without an answer (e.g. the subsystem shuts down) its result reports bWasCancelled.
+ */
+template <typename ResultType>
+struct TGoTask
+{
+	int32 RequestId = 0;
+	UE::Tasks::TTask<ResultType> Task;
+
+	//~ UGoSubsystem::CancelRequest: the task completes right away with bWasCancelled.
+	bool Cancel(UGoSubsystem& Subsystem) const { return Subsystem.CancelRequest(RequestId); }
+};
+using FGoRequestTask = TGoTask<FGoRequestResult>;
+using FGoFindSessionsTask = TGoTask<FGoFindSessionsResult>;
+
+//~ One task per UGoSubsystem request; parameters and results are those of the matching Go* call.
+namespace EOSGo::Tasks
+{
+	EOSGO_API FGoRequestTask Login(UGoSubsystem& Subsystem, const FString& Id, const FString& Token, const FString& LoginType);
+	EOSGO_API FGoRequestTask AutoLogin(UGoSubsystem& Subsystem);
+	EOSGO_API FGoRequestTask InteractiveLogin(UGoSubsystem& Subsystem);
+
+	EOSGO_API FGoRequestTask CreateSession(UGoSubsystem& Subsystem, int32 NumberOfConnections, const FString& MatchType, int32 ServerPrivateJoinId,
+		bool bIsPrivateSession, FName SessionName = NAME_GameSession);
+	EOSGO_API FGoRequestTask HostDedicatedSession(UGoSubsystem& Subsystem, FName MatchType, int32 NumberOfConnections = 0);
+	//~ The lobby's session name is also the result's SessionName.
+	EOSGO_API FGoRequestTask HostDedicatedLobby(UGoSubsystem& Subsystem, FName MatchType, int32 NumberOfConnections = 0);
+	EOSGO_API FGoRequestTask UpdateSession(UGoSubsystem& Subsystem, const FOnlineSessionSettings& UpdateSessionSettings, FName SessionName = NAME_GameSession);
+	EOSGO_API FGoFindSessionsTask FindSessions(UGoSubsystem& Subsystem, int64 ServerJoinId, FName MatchType = NAME_None);
+	EOSGO_API FGoRequestTask JoinSession(UGoSubsystem& Subsystem, const FOnlineSessionSearchResult& SessionSearchResult);
+	EOSGO_API FGoRequestTask JoinBestSession(UGoSubsystem& Subsystem, const TArray<FOnlineSessionSearchResult>& SessionResults, FName PreferredMatchType = NAME_None);
+	EOSGO_API FGoRequestTask FindAndJoinSession(UGoSubsystem& Subsystem, int64 ServerJoinId, FName MatchType = NAME_None,
+		FGoSessionSearchPredicate JoinPredicate = FGoSessionSearchPredicate(), FGoOnFindSessionsBatch OnBatch = FGoOnFindSessionsBatch());
+	EOSGO_API FGoRequestTask JoinSessionByCode(UGoSubsystem& Subsystem, const FString& JoinCode);
+	EOSGO_API FGoRequestTask StartSession(UGoSubsystem& Subsystem, FName SessionName = NAME_GameSession);
+	EOSGO_API FGoRequestTask DestroySession(UGoSubsystem& Subsystem, FName SessionName = NAME_GameSession);
+	EOSGO_API FGoRequestTask QuickMatch(UGoSubsystem& Subsystem, FName MatchType, bool bSpeculativeHost = false);
+}
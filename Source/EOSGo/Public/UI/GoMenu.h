@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Blueprint/UserWidget.h"
+#include "Subsystem/GoRequest.h"
 #include "GoMenu.generated.h"
 class UGoSubsystem;
 class UButton;
@@ -25,11 +26,10 @@ public:
 	void GoMenuSetup(FString LobbyMapPath);
 
 protected:
-	//~ Session callbacks for the custom delegates on the GoSubsystem.
-	UFUNCTION()
-	void OnCreateSession(bool bWasSuccessful);
-	void OnFindSessions(const TArray<FOnlineSessionSearchResult>& SessionResults, bool  bWasSuccessful);
-	void OnJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	//~ Session callbacks, each passed with the GoSubsystem request it answers. Nothing stays bound between requests.
+	void OnCreateSession(const FGoRequestResult& Result);
+	void OnJoinSession(const FGoRequestResult& Result);
+	void OnQuickMatch(const FGoRequestResult& Result);
 	
 private:
 	//The subsystem designed to handle online functionality.
@@ -38,10 +38,15 @@ private:
 
 	//~ Menu setup - session creation parameters
 	FString LobbyMap {FString(TEXT("/EOSGo/Maps/LobbyMap?listen"))};
+	//~ Id to search for when joining. Hosted sessions get no id; they are joined by code.
 	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
 	int64 ServerJoinId = 0;
+	//~ Code typed by the player, as shown by the host's overlay (UGoSubsystem::GetJoinCode). Takes precedence over ServerJoinId.
+	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
+	FString JoinCode;
 	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
 	FString MatchType {FString(TEXT("DUO"))};
+	//~ Only used for match types that aren't registered on the GoSubsystem.
 	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
 	int32 NumberOfConnections{2};
 	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
@@ -55,6 +60,11 @@ private:
 	UButton* Login_Button;
 	UPROPERTY(meta = (BindWidget))
 	UButton* Quit_Button;
+	UPROPERTY(meta = (BindWidgetOptional))
+	UButton* QuickMatch_Button;
+	//~ Host while searching when Quick Match is used.
+	UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
+	bool bSpeculativeQuickMatch = false;
 
 	UFUNCTION()
 	void LoginButtonClicked();
@@ -63,7 +73,11 @@ private:
 	UFUNCTION()
 	void JoinLobbyButtonClicked();
 	UFUNCTION()
+	void QuickMatchButtonClicked();
+	UFUNCTION()
 	void QuitButtonClicked();
 	
+	void TravelToJoinedSession();
+	void SetSessionButtonsEnabled(bool bEnabled);
 	void MenuTearDown();
 };
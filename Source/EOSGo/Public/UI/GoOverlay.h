@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Subsystem/GoRequest.h"
 #include "GoOverlay.generated.h"
 class UTextBlock;
 class AGoGameModeBase;
@@ -27,11 +28,9 @@ public:
 	void GoOverlaySetup();
 
 protected:
-	//~ Session callbacks for the custom delegates on the GoSubsystem.
-	UFUNCTION()
-	void OnDestroySession(bool bWasSuccessful);
-	UFUNCTION()
-	void OnStartSession(bool bWasSuccessful);
+	//~ Session callbacks, each passed with the GoSubsystem request it answers. Nothing stays bound between requests.
+	void OnDestroySession(const FGoRequestResult& Result);
+	void OnStartSession(const FGoRequestResult& Result);
 	
 private:
 	//The subsystem designed to handle online functionality.
@@ -46,6 +45,10 @@ private:
 	UButton* StartSession_Button;
 	UFUNCTION()
 	void StartSessionButtonClicked();
+
+	//~ Code other players join the session with.
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* JoinCode_Text;
 	
 	void MenuTearDown();
 };